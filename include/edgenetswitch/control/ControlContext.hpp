@@ -5,6 +5,11 @@
 #include "edgenetswitch/system/fd/FdRegistry.hpp"
 #include "edgenetswitch/transport/TransportManager.hpp"
 
+namespace edgenetswitch
+{
+    class PacketStats;
+}
+
 namespace edgenetswitch::daemon
 {
     class SnapshotPublisher;
@@ -27,6 +32,8 @@ namespace edgenetswitch::control
         SwitchForwardingEngine *forwarding_engine{nullptr};
         FdRegistry *fd_registry{nullptr};
         edgenetswitch::transport::TransportManager *transport_manager{};
+        // Owns the reset-on-read latency window reported by packet-stats:json.
+        PacketStats *packet_stats{nullptr};
     };
 
 } // namespace edgenetswitch::control
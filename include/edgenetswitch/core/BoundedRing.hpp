@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace edgenetswitch
+{
+    enum class RingProducerMode
+    {
+        // Exactly one thread ever calls tryPush(); the tail is advanced with a plain store.
+        Single,
+        // Any number of threads may call tryPush(); the tail is claimed with a CAS.
+        Multi
+    };
+
+    // Fixed-capacity lock-free ring with a single consumer.
+    //
+    // Each slot carries a sequence number (Vyukov bounded queue): a producer may fill slot
+    // `pos` only when its sequence equals `pos`, and the consumer may drain it only when the
+    // sequence equals `pos + 1`. A full ring rejects the push instead of blocking, which keeps
+    // the caller's overflow policy explicit.
+    template <typename T> class BoundedRing
+    {
+    public:
+        explicit BoundedRing(std::size_t capacity, RingProducerMode mode = RingProducerMode::Multi)
+            : capacity_(capacity), mask_(capacity - 1), mode_(mode),
+              slots_(std::make_unique<Slot[]>(capacity))
+        {
+            if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+            {
+                throw std::invalid_argument("BoundedRing capacity must be a power of two >= 2");
+            }
+
+            for (std::size_t i = 0; i < capacity_; ++i)
+            {
+                slots_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        BoundedRing(const BoundedRing &) = delete;
+        BoundedRing &operator=(const BoundedRing &) = delete;
+
+        // Returns false when the ring is full; `value` is left untouched in that case.
+        template <typename U> bool tryPush(U &&value)
+        {
+            std::size_t pos = tail_.load(std::memory_order_relaxed);
+            Slot *slot = nullptr;
+
+            while (true)
+            {
+                slot = &slots_[pos & mask_];
+                const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const auto diff =
+                    static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+                if (diff < 0)
+                    return false;
+
+                if (diff > 0)
+                {
+                    pos = tail_.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (mode_ == RingProducerMode::Single)
+                {
+                    tail_.store(pos + 1, std::memory_order_relaxed);
+                    break;
+                }
+
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+
+            slot->value = std::forward<U>(value);
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side only. Returns false when no published element is available.
+        bool tryPop(T &out)
+        {
+            const std::size_t pos = head_.load(std::memory_order_relaxed);
+            Slot &slot = slots_[pos & mask_];
+            const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+            if (sequence != pos + 1)
+                return false;
+
+            out = std::move(slot.value);
+            head_.store(pos + 1, std::memory_order_relaxed);
+            slot.sequence.store(pos + capacity_, std::memory_order_release);
+            return true;
+        }
+
+        // Approximate when producers or the consumer are active concurrently.
+        [[nodiscard]]
+        bool empty() const noexcept
+        {
+            const std::size_t pos = head_.load(std::memory_order_relaxed);
+            return slots_[pos & mask_].sequence.load(std::memory_order_acquire) != pos + 1;
+        }
+
+        [[nodiscard]]
+        std::size_t sizeApprox() const noexcept
+        {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            return tail >= head ? tail - head : 0;
+        }
+
+        [[nodiscard]]
+        std::size_t capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+    private:
+        static constexpr std::size_t CacheLine = 64;
+
+        struct Slot
+        {
+            std::atomic<std::size_t> sequence{0};
+            T value{};
+        };
+
+        const std::size_t capacity_;
+        const std::size_t mask_;
+        const RingProducerMode mode_;
+        std::unique_ptr<Slot[]> slots_;
+
+        // Producers and the consumer advance separate cache lines.
+        alignas(CacheLine) std::atomic<std::size_t> tail_{0};
+        alignas(CacheLine) std::atomic<std::size_t> head_{0};
+    };
+} // namespace edgenetswitch
@@ -21,6 +21,24 @@ namespace edgenetswitch::core
     {
         bool enabled{false};
         int port{9000};
+        // Datagrams pulled per recvmmsg() call; 1 keeps the per-datagram recvfrom() path.
+        std::uint32_t batch_size{32};
+        // SO_REUSEPORT sockets bound to the same port, each served by its own epoll thread.
+        std::uint32_t receivers{1};
+        // Preallocated datagram buffers per receiver; ingress drops packets once they run out.
+        std::uint32_t buffer_pool_slabs{4096};
+    };
+
+    struct ProcessorConfig
+    {
+        // PacketProcessor worker threads; packets are pinned to a worker by flow hash.
+        std::uint32_t workers{1};
+    };
+
+    struct SwitchingConfig
+    {
+        // MAC entries unseen for longer than this are aged out on the daemon tick; 0 disables.
+        std::uint64_t mac_age_ms{300000};
     };
 
     struct RateConfig
@@ -34,6 +52,8 @@ namespace edgenetswitch::core
         LogConfig log;
         DaemonConfig daemon;
         UdpConfig udp;
+        ProcessorConfig processor;
+        SwitchingConfig switching;
         RateConfig rate;
     };
 
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <x86intrin.h>
+#define EDGENETSWITCH_CYCLE_CLOCK_TSC 1
+#endif
+
+namespace edgenetswitch
+{
+    // Cheap monotonic tick source for per-packet stage timing. On x86-64 with an invariant TSC
+    // (constant rate, synchronized across cores) a tick is one TSC count read with rdtsc;
+    // otherwise a tick is one steady_clock nanosecond. Ticks are only meaningful as differences
+    // and are converted with toNs().
+    class CycleClock
+    {
+    public:
+        static std::uint64_t now() noexcept
+        {
+#ifdef EDGENETSWITCH_CYCLE_CLOCK_TSC
+            if (usesTsc())
+                return __rdtsc();
+#endif
+            return steadyNs();
+        }
+
+        static std::uint64_t toNs(std::uint64_t ticks) noexcept
+        {
+            return static_cast<std::uint64_t>(static_cast<double>(ticks) * nsPerTick());
+        }
+
+        // Measured once, on first use; blocks for about 10 ms on TSC hosts. Call it at startup
+        // to keep the calibration off the packet path.
+        static double nsPerTick() noexcept
+        {
+            static const double ns_per_tick = calibrate();
+            return ns_per_tick;
+        }
+
+        static bool usesTsc() noexcept
+        {
+#ifdef EDGENETSWITCH_CYCLE_CLOCK_TSC
+            static const bool invariant_tsc = []
+            {
+                unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+                // CPUID.80000007H:EDX[8] advertises the invariant TSC.
+                return __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx) != 0 &&
+                       (edx & (1u << 8)) != 0;
+            }();
+            return invariant_tsc;
+#else
+            return false;
+#endif
+        }
+
+    private:
+        static std::uint64_t steadyNs() noexcept
+        {
+            return static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch())
+                    .count());
+        }
+
+        static double calibrate() noexcept
+        {
+            if (!usesTsc())
+                return 1.0;
+
+            const std::uint64_t ns_start = steadyNs();
+            const std::uint64_t ticks_start = now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            const std::uint64_t ns_elapsed = steadyNs() - ns_start;
+            const std::uint64_t ticks_elapsed = now() - ticks_start;
+
+            return ticks_elapsed != 0
+                       ? static_cast<double>(ns_elapsed) / static_cast<double>(ticks_elapsed)
+                       : 1.0;
+        }
+    };
+} // namespace edgenetswitch
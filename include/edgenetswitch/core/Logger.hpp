@@ -1,9 +1,24 @@
 #pragma once
 
+#include "edgenetswitch/core/BoundedRing.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <fstream>
 #include <mutex>
 #include <memory>
+#include <thread>
+#include <vector>
+
+// Lowest level, as a LogLevel ordinal, that the EDGENETSWITCH_LOG_* macros compile in.
+// Set from the EDGENETSWITCH_LOG_MIN_LEVEL CMake cache variable.
+#ifndef EDGENETSWITCH_LOG_MIN_LEVEL
+#define EDGENETSWITCH_LOG_MIN_LEVEL 0
+#endif
 
 enum class LogLevel
 {
@@ -13,9 +28,75 @@ enum class LogLevel
     Error
 };
 
+// Per-call-site limiter for log lines that can repeat once per packet. Of every `sample_every`
+// calls one is considered, and a considered call passes only if a token bucket refilled at
+// `per_second` lines per second (burst of the same size) has a token. Everything else is
+// counted as suppressed. Limiters register themselves so Logger::reportSuppressed() and the
+// `log-stats` control command can show what was held back.
+class LogRateLimiter
+{
+public:
+    LogRateLimiter(std::string name, std::uint32_t per_second, std::uint32_t sample_every = 1);
+    ~LogRateLimiter();
+
+    LogRateLimiter(const LogRateLimiter &) = delete;
+    LogRateLimiter &operator=(const LogRateLimiter &) = delete;
+
+    // True when the caller should emit its line. Lock-free; safe from any thread.
+    bool allow() noexcept;
+
+    [[nodiscard]]
+    const std::string &name() const noexcept
+    {
+        return name_;
+    }
+
+    [[nodiscard]]
+    std::uint64_t emitted() const noexcept
+    {
+        return emitted_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    std::uint64_t suppressed() const noexcept
+    {
+        return suppressed_.load(std::memory_order_relaxed);
+    }
+
+private:
+    friend class Logger;
+
+    bool takeToken() noexcept;
+
+    std::string name_;
+    std::uint64_t interval_ns_;  // one token's worth of time
+    std::uint64_t tolerance_ns_; // how far ahead of now the bucket may be drawn (burst - 1)
+    std::uint32_t sample_every_;
+
+    std::atomic<std::uint64_t> calls_{0};
+    std::atomic<std::uint64_t> next_token_ns_{0}; // theoretical arrival time of the next token
+    std::atomic<std::uint64_t> emitted_{0};
+    std::atomic<std::uint64_t> suppressed_{0};
+    std::uint64_t reported_suppressed_{0}; // guarded by the limiter registry mutex
+};
+
+struct LogSiteStats
+{
+    std::string name;
+    std::uint64_t emitted{0};
+    std::uint64_t suppressed{0};
+};
+
+// Asynchronous logger. Callers enqueue into a lock-free ring owned by their thread and return;
+// one writer thread drains every ring, formats timestamps, and writes each batch to stdout and
+// the log file with a single flush. A full ring drops the line and counts it instead of
+// blocking the caller. shutdown() drains everything still queued before returning.
 class Logger
 {
 public:
+    // Lines each thread may have queued before further lines are dropped.
+    static constexpr std::size_t RingCapacity = 1024;
+
     static void init(LogLevel level, const std::string &filePath);
     static void shutdown();
     ~Logger();
@@ -27,14 +108,107 @@ public:
     static void warn(const std::string &msg);
     static void error(const std::string &msg);
 
+    // Lines dropped because the calling thread's ring was full, since init().
+    static std::uint64_t droppedCount();
+
+    // Logs one warning for each rate-limited site that suppressed lines since the previous
+    // call. The daemon calls it once per tick.
+    static void reportSuppressed();
+
+    // Totals for every registered LogRateLimiter, in registration order.
+    static std::vector<LogSiteStats> rateLimitedSites();
+
+    // True when a line at `level` would be logged right now; false before init().
+    static bool enabled(LogLevel level) noexcept
+    {
+        return static_cast<int>(level) >= threshold_.load(std::memory_order_relaxed);
+    }
+
 private:
+    static constexpr int Disabled = static_cast<int>(LogLevel::Error) + 1;
+
+    struct Record
+    {
+        LogLevel level{LogLevel::Info};
+        std::chrono::system_clock::time_point time{};
+        std::string msg;
+    };
+
+    struct ThreadRing
+    {
+        ThreadRing() : ring(RingCapacity, edgenetswitch::RingProducerMode::Single) {}
+
+        edgenetswitch::BoundedRing<Record> ring;
+        std::atomic<bool> retired{false}; // owning thread exited; drop once drained
+    };
+
     Logger(LogLevel level, const std::string &filePath);
 
     void log(LogLevel level, const std::string &msg);
+    ThreadRing &ringForThisThread();
+    void writerLoop();
+    // Writer thread only. Returns false when every ring was empty.
+    bool drainOnce();
 
     LogLevel minLevel_;
     std::ofstream file_;
-    std::mutex mutex_;
+    const std::uint64_t generation_;
+
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<ThreadRing>> rings_;
+
+    std::atomic<std::uint64_t> dropped_{0};
+    std::uint64_t reported_dropped_{0};
+
+    std::vector<Record> batch_;
+    std::string out_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    bool stopping_{false};
+    std::thread writer_;
 
     static std::unique_ptr<Logger> instance_;
-};
\ No newline at end of file
+    inline static std::atomic<int> threshold_{Disabled};
+};
+
+// Check the level before the message expression is evaluated, so a disabled call costs one
+// load and a branch and builds no string. Calls below EDGENETSWITCH_LOG_MIN_LEVEL compile to
+// nothing. Usage: EDGENETSWITCH_LOG_INFO("id=" + std::to_string(id));
+#define EDGENETSWITCH_LOG_AT(level, method, ...)                                                   \
+    do                                                                                             \
+    {                                                                                              \
+        if (static_cast<int>(level) >= EDGENETSWITCH_LOG_MIN_LEVEL && ::Logger::enabled(level))    \
+            ::Logger::method(__VA_ARGS__);                                                         \
+    } while (false)
+
+// As above, but through a LogRateLimiter owned by the call site; `site` names it in reports.
+// Usage: EDGENETSWITCH_LOG_WARN_LIMITED("udp.parse_drop", 10, 1, "dropped " + detail);
+#define EDGENETSWITCH_LOG_LIMITED_AT(level, method, site, per_second, sample_every, ...)          \
+    do                                                                                             \
+    {                                                                                              \
+        if (static_cast<int>(level) >= EDGENETSWITCH_LOG_MIN_LEVEL && ::Logger::enabled(level))    \
+        {                                                                                          \
+            static ::LogRateLimiter edgenetswitch_log_limiter_(site, per_second, sample_every);    \
+            if (edgenetswitch_log_limiter_.allow())                                                \
+                ::Logger::method(__VA_ARGS__);                                                     \
+        }                                                                                          \
+    } while (false)
+
+#define EDGENETSWITCH_LOG_DEBUG(...) EDGENETSWITCH_LOG_AT(::LogLevel::Debug, debug, __VA_ARGS__)
+#define EDGENETSWITCH_LOG_INFO(...) EDGENETSWITCH_LOG_AT(::LogLevel::Info, info, __VA_ARGS__)
+#define EDGENETSWITCH_LOG_WARN(...) EDGENETSWITCH_LOG_AT(::LogLevel::Warning, warn, __VA_ARGS__)
+#define EDGENETSWITCH_LOG_ERROR(...) EDGENETSWITCH_LOG_AT(::LogLevel::Error, error, __VA_ARGS__)
+
+#define EDGENETSWITCH_LOG_DEBUG_LIMITED(site, per_second, sample_every, ...)                      \
+    EDGENETSWITCH_LOG_LIMITED_AT(::LogLevel::Debug, debug, site, per_second, sample_every,         \
+                                 __VA_ARGS__)
+#define EDGENETSWITCH_LOG_INFO_LIMITED(site, per_second, sample_every, ...)                       \
+    EDGENETSWITCH_LOG_LIMITED_AT(::LogLevel::Info, info, site, per_second, sample_every,           \
+                                 __VA_ARGS__)
+#define EDGENETSWITCH_LOG_WARN_LIMITED(site, per_second, sample_every, ...)                       \
+    EDGENETSWITCH_LOG_LIMITED_AT(::LogLevel::Warning, warn, site, per_second, sample_every,        \
+                                 __VA_ARGS__)
+#define EDGENETSWITCH_LOG_ERROR_LIMITED(site, per_second, sample_every, ...)                      \
+    EDGENETSWITCH_LOG_LIMITED_AT(::LogLevel::Error, error, site, per_second, sample_every,         \
+                                 __VA_ARGS__)
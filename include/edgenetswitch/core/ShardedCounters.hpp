@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace edgenetswitch
+{
+    namespace detail
+    {
+        // Round-robin shard assignment, fixed for the life of the thread.
+        inline std::size_t counterShardForThisThread() noexcept
+        {
+            static std::atomic<std::size_t> next_shard{0};
+            thread_local const std::size_t shard =
+                next_shard.fetch_add(1, std::memory_order_relaxed);
+            return shard;
+        }
+    } // namespace detail
+
+    // A block of N monotonic counters split into cache-line-aligned per-thread shards. Each
+    // thread adds to its own shard, so hot counters bumped by the receiver, the workers and
+    // the control thread never share a cache line; readers sum every shard. Sums are not a
+    // consistent cut across counters while writers run. Threads beyond Shards share shards,
+    // which stays correct because every shard update is atomic.
+    template <std::size_t N> class ShardedCounters
+    {
+    public:
+        static constexpr std::size_t Shards = 32;
+
+        void add(std::size_t counter, std::uint64_t delta = 1) noexcept
+        {
+            shards_[detail::counterShardForThisThread() % Shards].values[counter].fetch_add(
+                delta, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        std::uint64_t load(std::size_t counter) const noexcept
+        {
+            std::uint64_t total = 0;
+
+            for (const auto &shard : shards_)
+                total += shard.values[counter].load(std::memory_order_relaxed);
+
+            return total;
+        }
+
+        [[nodiscard]]
+        std::array<std::uint64_t, N> snapshot() const noexcept
+        {
+            std::array<std::uint64_t, N> totals{};
+
+            for (const auto &shard : shards_)
+            {
+                for (std::size_t counter = 0; counter < N; ++counter)
+                    totals[counter] += shard.values[counter].load(std::memory_order_relaxed);
+            }
+
+            return totals;
+        }
+
+        // Adds racing with reset() may survive it.
+        void reset() noexcept
+        {
+            for (auto &shard : shards_)
+            {
+                for (auto &value : shard.values)
+                    value.store(0, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        static constexpr std::size_t CacheLine = 64;
+
+        struct alignas(CacheLine) Shard
+        {
+            std::array<std::atomic<std::uint64_t>, N> values{};
+        };
+
+        std::array<Shard, Shards> shards_{};
+    };
+} // namespace edgenetswitch
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
@@ -48,10 +49,14 @@ namespace edgenetswitch::failure
     {
     public:
         explicit FailureInjector(const FailureConfig &cfg);
+        FailureInjector(const FailureInjector &other);
+        FailureInjector &operator=(const FailureInjector &other);
+
+        // Safe to call from several ingress threads at once.
         FailureResult inject(const Packet &pkt, std::uint64_t now);
 
     private:
         FailureConfig config_;
-        std::uint64_t seen_packets_{0};
+        std::atomic<std::uint64_t> seen_packets_{0};
     };
 } // namespace edgenetswitch::failure
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -26,12 +29,25 @@ namespace edgenetswitch
         PacketProcessed,
         PacketDropped,
         ForwardingDecisionMade,
-        IngressIdlePoll
+        IngressIdlePoll,
+        IngressBatchReceived
     };
 
+    // Keep in sync with the last MessageType enumerator; sizes the bus's subscriber table.
+    inline constexpr std::size_t MESSAGE_TYPE_COUNT =
+        static_cast<std::size_t>(MessageType::IngressBatchReceived) + 1;
+
     struct IngressIdlePoll
     {
         std::uint64_t timestamp_ms{0};
+        std::uint32_t receiver_id{0};
+    };
+
+    struct IngressBatchReceived
+    {
+        std::uint32_t datagram_count{0};
+        std::uint64_t timestamp_ms{0};
+        std::uint32_t receiver_id{0};
     };
 
     struct TelemetryData
@@ -54,7 +70,8 @@ namespace edgenetswitch
         MessageType type;
         std::uint64_t timestamp_ms;
         using Payload = std::variant<std::monostate, TelemetryData, HealthStatus, Packet,
-                                     PacketDropped, ForwardingEvent, IngressIdlePoll>;
+                                     PacketDropped, ForwardingEvent, IngressIdlePoll,
+                                     IngressBatchReceived>;
         Payload payload{};
     };
 
@@ -62,6 +79,8 @@ namespace edgenetswitch
     {
     public:
         using Callback = std::function<void(const Message &)>;
+        // Owning subscriber: runs after every Callback of the type and may move the payload out.
+        using SinkCallback = std::function<void(Message &&)>;
 
         MessagingBus() = default;
         ~MessagingBus() = default;
@@ -73,10 +92,36 @@ namespace edgenetswitch
         MessagingBus &operator=(const MessagingBus &) = delete;
 
         void subscribe(MessageType type, Callback Callback);
+
+        // Sinks run in subscription order once all observers have returned. Every sink but the
+        // last one of an rvalue publish receives its own copy of the message.
+        void subscribeSink(MessageType type, SinkCallback sink);
+
+        // The subscriber lookup is lock-free: one acquire load of the type's subscriber snapshot.
+        // Sinks receive a copy of the message, which allocates when it owns payload storage.
         void publish(const Message &message);
 
+        // As above, but the last sink takes ownership of the message instead of a copy.
+        void publish(Message &&message);
+
     private:
-        std::unordered_map<MessageType, std::vector<Callback>> subscribers_;
-        std::mutex mutex_;
+        struct Subscribers
+        {
+            std::vector<Callback> observers;
+            std::vector<SinkCallback> sinks;
+        };
+
+        [[nodiscard]]
+        const Subscribers *subscribersFor(MessageType type) const noexcept;
+
+        template <typename Mutate> void update(MessageType type, Mutate &&mutate);
+
+        // Each slot points at an immutable subscriber list. Subscribing publishes a new copy and
+        // keeps every list ever published alive in snapshots_ until the bus is destroyed, so a
+        // publisher holding an older snapshot can keep iterating it without a refcount.
+        // Subscriptions happen during wiring, so the retained copies stay small.
+        std::array<std::atomic<const Subscribers *>, MESSAGE_TYPE_COUNT> subscribers_{};
+        std::vector<std::unique_ptr<const Subscribers>> snapshots_;
+        std::mutex subscribe_mutex_;
     };
 } // namespace edgenetswitch
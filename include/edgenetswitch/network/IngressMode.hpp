@@ -5,6 +5,8 @@ namespace edgenetswitch
     enum class IngressMode
     {
         Blocking,
-        NonBlocking
+        NonBlocking,
+        // Non-blocking socket drained with recvmmsg() into preallocated batch buffers.
+        Batched
     };
 }
\ No newline at end of file
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
 
 #include "edgenetswitch/messaging/MessagingBus.hpp"
 #include "edgenetswitch/network/IngressMode.hpp"
 #include "edgenetswitch/packet/LifecycleIdGenerator.hpp"
+#include "edgenetswitch/packet/PacketBufferPool.hpp"
 #include "edgenetswitch/system/fd/FdRegistry.hpp"
 #include "edgenetswitch/system/fd/FileDescriptor.hpp"
 
@@ -22,8 +30,14 @@ namespace edgenetswitch
     class UdpReceiver
     {
     public:
+        static constexpr std::size_t MaxDatagramSize = 1024;
+        static constexpr std::size_t DefaultBatchSize = 32;
+
         UdpReceiver(MessagingBus &bus, int port, FdRegistry *fd_registry,
-                    IngressMode ingress_mode = IngressMode::Blocking);
+                    IngressMode ingress_mode = IngressMode::Blocking,
+                    std::size_t batch_size = DefaultBatchSize, std::uint32_t receiver_id = 0,
+                    std::uint32_t receiver_count = 1,
+                    PacketBufferPool *buffer_pool = nullptr);
         ~UdpReceiver();
 
         void initializeSocket();
@@ -33,19 +47,37 @@ namespace edgenetswitch
         [[nodiscard]]
         int fd() const noexcept;
 
+        [[nodiscard]]
+        std::uint32_t receiverId() const noexcept;
+
         void processReadableEvent();
 
     private:
         void run();
         UdpReadResult handleReadable();
+        UdpReadResult handleReadableBatch(std::size_t budget, std::size_t &received);
+        UdpReadResult handleReceiveError(int error);
+        void handleDatagram(const char *data, std::size_t len, const sockaddr_in &client_addr,
+                            socklen_t addr_len, std::uint64_t ingress_ts);
 
         MessagingBus &bus_;
         int port_;
+        std::uint32_t receiver_id_{0};
+        std::uint32_t receiver_count_{1};
         FileDescriptor socket_fd_;
         FdRegistry *fd_registry_{nullptr};
+        // Shard `receiver_id_` holds this receiver's slabs; without a pool payloads are owned.
+        PacketBufferPool *buffer_pool_{nullptr};
         std::atomic_bool running_{false};
         std::thread worker_;
         LifecycleIdGenerator lifecycle_gen_;
         IngressMode ingress_mode_{IngressMode::Blocking};
+
+        // recvmmsg() state, allocated once at construction and reused for every batch.
+        std::size_t batch_size_{DefaultBatchSize};
+        std::vector<std::array<char, MaxDatagramSize>> batch_buffers_;
+        std::vector<sockaddr_in> batch_addrs_;
+        std::vector<iovec> batch_iovecs_;
+        std::vector<mmsghdr> batch_headers_;
     };
 } // namespace edgenetswitch
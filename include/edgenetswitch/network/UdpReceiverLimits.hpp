@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+namespace edgenetswitch
+{
+    // Upper bound on SO_REUSEPORT ingress receivers; sizes the per-receiver counter arrays.
+    inline constexpr std::size_t MAX_UDP_RECEIVERS = 16;
+
+    // Datagrams a receiver drains per readable event; recvmmsg() never asks for more, so it
+    // also caps udp.batch_size.
+    inline constexpr std::size_t MAX_UDP_BATCH_SIZE = 256;
+} // namespace edgenetswitch
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace edgenetswitch
+{
+    enum class LifecycleMark
+    {
+        New,       // first terminal event seen for this id
+        Duplicate, // id was already marked
+        TooOld     // id fell behind the window; it can no longer be checked
+    };
+
+    // Sliding-window duplicate detector for one monotonically issued id sequence. The window is a
+    // ring of Slots bitmaps, each covering IdsPerSlot consecutive ids and tagged with the block
+    // (id / IdsPerSlot) it currently holds. Marking an id in a newer block than its slot holds
+    // recycles the slot, which moves the low watermark forward; an id whose slot already holds
+    // a newer block is reported TooOld rather than guessed at. Memory is constant and mark() is
+    // a lock-free CAS on one word, safe from any thread. Tags are compared modulo 2^32 blocks,
+    // so ids marked together must stay within 2^31 blocks (about 6.8e10 ids) of each other.
+    // Interleaved sequences that can advance at different rates each need their own window.
+    class LifecycleDedupWindow
+    {
+    public:
+        static constexpr std::size_t Slots = 4096;
+        static constexpr std::size_t IdsPerSlot = 32;
+        // Ids at least this far behind the newest marked id may be reported TooOld.
+        static constexpr std::uint64_t Span = Slots * IdsPerSlot;
+
+        LifecycleMark mark(std::uint64_t lifecycle_id) noexcept;
+
+    private:
+        // Slot word: block tag in the high 32 bits, one bit per id in the low 32. A zero bitmap
+        // means the slot is unused, since installing a block sets the bit of the id that did it.
+        static constexpr std::uint64_t BitsMask = 0xFFFF'FFFFull;
+
+        std::array<std::atomic<std::uint64_t>, Slots> slots_{};
+    };
+
+    inline LifecycleMark LifecycleDedupWindow::mark(std::uint64_t lifecycle_id) noexcept
+    {
+        const std::uint64_t block = lifecycle_id / IdsPerSlot;
+        const auto tag = static_cast<std::uint32_t>(block);
+        const std::uint64_t bit = 1ull << (lifecycle_id % IdsPerSlot);
+
+        auto &slot = slots_[block % Slots];
+        std::uint64_t word = slot.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            const auto held_tag = static_cast<std::uint32_t>(word >> 32);
+            std::uint64_t desired = 0;
+
+            if ((word & BitsMask) == 0 || static_cast<std::int32_t>(tag - held_tag) > 0)
+            {
+                // Unused slot, or it holds an older block: recycle it for this one.
+                desired = (std::uint64_t{tag} << 32) | bit;
+            }
+            else if (held_tag == tag)
+            {
+                if (word & bit)
+                    return LifecycleMark::Duplicate;
+
+                desired = word | bit;
+            }
+            else
+            {
+                return LifecycleMark::TooOld;
+            }
+
+            if (slot.compare_exchange_weak(word, desired, std::memory_order_relaxed))
+                return LifecycleMark::New;
+        }
+    }
+} // namespace edgenetswitch
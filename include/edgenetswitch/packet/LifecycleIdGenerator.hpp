@@ -8,12 +8,22 @@ namespace edgenetswitch
     class LifecycleIdGenerator
     {
     public:
+        LifecycleIdGenerator() = default;
+
+        // Issues first, first + stride, first + 2 * stride, ... so that several generators
+        // with distinct offsets and a shared stride never hand out the same id.
+        LifecycleIdGenerator(uint64_t first, uint64_t stride)
+            : counter_(first), stride_(stride == 0 ? 1 : stride)
+        {
+        }
+
         uint64_t next()
         {
-            return counter_.fetch_add(1, std::memory_order_relaxed);
+            return counter_.fetch_add(stride_, std::memory_order_relaxed);
         }
 
     private:
         std::atomic<uint64_t> counter_{1};
+        uint64_t stride_{1};
     };
 } // namespace edgenetswitch
\ No newline at end of file
@@ -1,6 +1,10 @@
 #pragma once
+#include "edgenetswitch/packet/PacketPayload.hpp"
+#include "edgenetswitch/packet/PipelineStamps.hpp"
 #include "edgenetswitch/switching/MacAddress.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
 
 namespace edgenetswitch
@@ -14,31 +18,160 @@ namespace edgenetswitch
         RateLimited,
         ProcessingError,
         InternalError,
+        BufferExhausted,
         Unknown
     };
 
+    // Keep in sync with the last PacketDropReason enumerator; sizes the drop counter arrays.
+    inline constexpr std::size_t PACKET_DROP_REASON_COUNT =
+        static_cast<std::size_t>(PacketDropReason::Unknown) + 1;
+
+    // Pipeline component that gave up on the packet.
+    enum class PacketDropSource
+    {
+        Ingress,        // UdpReceiver: parse, validation or buffer pool failures
+        Processor,      // PacketProcessor: admission overflow and processing-time validation
+        FailureInjector // PacketProcessor::handleInjectedFailure
+    };
+
+    // Keep in sync with the last PacketDropSource enumerator.
+    inline constexpr std::size_t PACKET_DROP_SOURCE_COUNT =
+        static_cast<std::size_t>(PacketDropSource::FailureInjector) + 1;
+
     struct PacketDropped
     {
         PacketDropReason reason;
+        PacketDropSource source{PacketDropSource::Ingress};
         std::uint64_t timestamp_ms;
         std::uint64_t packet_id{0};
         std::uint64_t lifecycle_id{0};
+        std::optional<std::uint32_t> processor_worker{}; // worker that owned the packet, if any
     };
 
-    struct Packet
+    // Ingress wire format a packet was parsed from (see PacketParser.hpp).
+    enum class PacketWireFormat : std::uint8_t
+    {
+        Text,  // `id=<u64>;payload=<bytes>`, payload is printable text
+        Binary // fixed header, payload is arbitrary bytes
+    };
+
+    // Builds a host-order IPv4 address from its dotted-quad octets.
+    constexpr std::uint32_t makeIpv4(std::uint8_t a, std::uint8_t b, std::uint8_t c,
+                                     std::uint8_t d) noexcept
+    {
+        return (std::uint32_t{a} << 24) | (std::uint32_t{b} << 16) | (std::uint32_t{c} << 8) |
+               std::uint32_t{d};
+    }
+
+    // Dotted-quad text for logging and control output; never on the packet path.
+    inline std::string formatIpv4(std::uint32_t address)
+    {
+        return std::to_string((address >> 24) & 0xFFu) + "." +
+               std::to_string((address >> 16) & 0xFFu) + "." +
+               std::to_string((address >> 8) & 0xFFu) + "." + std::to_string(address & 0xFFu);
+    }
+
+    // Fields every hop reads (receiver, validator, processor, forwarding, stats), kept in a
+    // single cache line. MACs and the ingress port are stored inline with one presence byte
+    // instead of as std::optional members, which is what lets them fit.
+    struct alignas(64) PacketHeader
     {
         std::uint64_t id{0};
         std::uint64_t lifecycle_id{0};
-        std::string payload;
         std::uint64_t timestamp_ms{0};
+        std::uint64_t ingress_timestamp_ns{0};
         std::uint32_t wire_size{0};    // raw packet size coming from UDP
         std::uint32_t payload_size{0}; // parsed packet size
-        bool valid{false};
-        std::string source_ip{};
+        std::uint32_t source_ipv4{0};  // host byte order; 0 when the source is unknown
         std::uint16_t source_port{0};
-        std::optional<MacAddress> source_mac;
-        std::optional<MacAddress> destination_mac;
-        std::optional<std::uint32_t> ingress_port;
-        std::uint64_t ingress_timestamp_ns{0};
+        bool valid{false};
+
+        [[nodiscard]]
+        std::optional<MacAddress> sourceMac() const
+        {
+            if (!(present_ & SourceMacPresent))
+                return std::nullopt;
+
+            return MacAddress(source_mac_);
+        }
+
+        void setSourceMac(const std::optional<MacAddress> &mac) noexcept
+        {
+            store(mac, source_mac_, SourceMacPresent);
+        }
+
+        [[nodiscard]]
+        std::optional<MacAddress> destinationMac() const
+        {
+            if (!(present_ & DestinationMacPresent))
+                return std::nullopt;
+
+            return MacAddress(destination_mac_);
+        }
+
+        void setDestinationMac(const std::optional<MacAddress> &mac) noexcept
+        {
+            store(mac, destination_mac_, DestinationMacPresent);
+        }
+
+        [[nodiscard]]
+        std::optional<std::uint32_t> ingressPort() const noexcept
+        {
+            if (!(present_ & IngressPortPresent))
+                return std::nullopt;
+
+            return ingress_port_;
+        }
+
+        void setIngressPort(std::optional<std::uint32_t> port) noexcept
+        {
+            ingress_port_ = port.value_or(0);
+            present_ = static_cast<std::uint8_t>(port ? (present_ | IngressPortPresent)
+                                                      : (present_ & ~IngressPortPresent));
+        }
+
+        [[nodiscard]]
+        PacketWireFormat wireFormat() const noexcept
+        {
+            return (present_ & BinaryFormat) ? PacketWireFormat::Binary : PacketWireFormat::Text;
+        }
+
+        void setWireFormat(PacketWireFormat format) noexcept
+        {
+            present_ = static_cast<std::uint8_t>(format == PacketWireFormat::Binary
+                                                     ? (present_ | BinaryFormat)
+                                                     : (present_ & ~BinaryFormat));
+        }
+
+    private:
+        static constexpr std::uint8_t SourceMacPresent = 1u << 0;
+        static constexpr std::uint8_t DestinationMacPresent = 1u << 1;
+        static constexpr std::uint8_t IngressPortPresent = 1u << 2;
+        static constexpr std::uint8_t BinaryFormat = 1u << 3;
+
+        void store(const std::optional<MacAddress> &mac, MacAddress::Bytes &slot,
+                   std::uint8_t bit) noexcept
+        {
+            slot = mac ? mac->bytes() : MacAddress::Bytes{};
+            present_ = static_cast<std::uint8_t>(mac ? (present_ | bit) : (present_ & ~bit));
+        }
+
+        std::uint8_t present_{0}; // presence bits and wire format; fills the byte after `valid`
+        std::uint32_t ingress_port_{0};
+        MacAddress::Bytes source_mac_{};
+        MacAddress::Bytes destination_mac_{};
+    };
+
+    static_assert(sizeof(PacketHeader) == 64, "PacketHeader must stay within one cache line");
+
+    // The header comes first so it owns the packet's first cache line; the payload handle and
+    // pipeline bookkeeping follow on the next one.
+    struct Packet : PacketHeader
+    {
+        PacketPayload payload;
+        std::optional<std::uint32_t> ingress_receiver; // set only for UDP ingress
+        std::optional<std::uint32_t> processor_worker; // set on PacketProcessor admission
+        std::uint64_t worker_enqueue_ns{0};            // steady clock, set with processor_worker
+        PipelineStamps stages;                         // per-stage timing, UDP ingress only
     };
 } // namespace edgenetswitch
@@ -0,0 +1,258 @@
+#pragma once
+
+#include "edgenetswitch/core/BoundedRing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace edgenetswitch
+{
+    class PacketBufferPool;
+
+    // Reference-counted handle to one pool slab. Copies share the slab; the slab returns to its
+    // pool when the last handle goes away, which for ingress packets is once the terminal event
+    // (PacketProcessed or PacketDropped) has been published and every holder has let go.
+    class PacketBuffer
+    {
+    public:
+        PacketBuffer() = default;
+        PacketBuffer(const PacketBuffer &other) noexcept;
+        PacketBuffer(PacketBuffer &&other) noexcept;
+        PacketBuffer &operator=(const PacketBuffer &other) noexcept;
+        PacketBuffer &operator=(PacketBuffer &&other) noexcept;
+        ~PacketBuffer();
+
+        [[nodiscard]]
+        bool valid() const noexcept
+        {
+            return pool_ != nullptr;
+        }
+
+        [[nodiscard]]
+        char *data() const noexcept;
+
+        [[nodiscard]]
+        std::size_t capacity() const noexcept;
+
+        void reset() noexcept;
+
+    private:
+        friend class PacketBufferPool;
+
+        PacketBuffer(PacketBufferPool *pool, std::uint32_t slab) noexcept
+            : pool_(pool), slab_(slab)
+        {
+        }
+
+        PacketBufferPool *pool_{nullptr};
+        std::uint32_t slab_{0};
+    };
+
+    // Preallocated fixed-size slabs for ingress datagrams, split into one shard per receiver.
+    // acquire() pops from the shard's free ring and must only be called by that shard's
+    // receiver thread; slabs may be released from any thread and go back to their home shard.
+    // The pool must outlive every PacketBuffer it hands out.
+    class PacketBufferPool
+    {
+    public:
+        static constexpr std::size_t SlabSize = 1024;
+
+        // Throws std::invalid_argument if either count is zero.
+        explicit PacketBufferPool(std::size_t slabs_per_shard, std::uint32_t shard_count = 1);
+
+        PacketBufferPool(const PacketBufferPool &) = delete;
+        PacketBufferPool &operator=(const PacketBufferPool &) = delete;
+
+        // Returns an invalid buffer when the shard has no free slab.
+        [[nodiscard]]
+        PacketBuffer acquire(std::uint32_t shard);
+
+        [[nodiscard]]
+        std::size_t capacity() const noexcept;
+
+        // Slabs currently held by packets; approximate while packets are in flight.
+        [[nodiscard]]
+        std::size_t inUse() const noexcept;
+
+        [[nodiscard]]
+        std::uint32_t shardCount() const noexcept;
+
+    private:
+        friend class PacketBuffer;
+
+        static constexpr std::size_t CacheLine = 64;
+
+        struct SlabHeader
+        {
+            std::atomic<std::uint32_t> refs{0};
+            std::uint32_t shard{0};
+        };
+
+        struct alignas(CacheLine) Shard
+        {
+            explicit Shard(std::size_t ring_capacity) : free(ring_capacity) {}
+
+            BoundedRing<std::uint32_t> free;
+            std::atomic<std::size_t> in_use{0};
+        };
+
+        void retain(std::uint32_t slab) noexcept;
+        void release(std::uint32_t slab) noexcept;
+
+        std::size_t slab_count_{0};
+        std::unique_ptr<SlabHeader[]> headers_;
+        std::unique_ptr<char[]> storage_;
+        std::vector<std::unique_ptr<Shard>> shards_;
+    };
+
+    inline PacketBuffer::PacketBuffer(const PacketBuffer &other) noexcept
+        : pool_(other.pool_), slab_(other.slab_)
+    {
+        if (pool_)
+            pool_->retain(slab_);
+    }
+
+    inline PacketBuffer::PacketBuffer(PacketBuffer &&other) noexcept
+        : pool_(std::exchange(other.pool_, nullptr)), slab_(other.slab_)
+    {
+    }
+
+    inline PacketBuffer &PacketBuffer::operator=(const PacketBuffer &other) noexcept
+    {
+        if (this != &other)
+        {
+            PacketBuffer copy(other);
+            *this = std::move(copy);
+        }
+
+        return *this;
+    }
+
+    inline PacketBuffer &PacketBuffer::operator=(PacketBuffer &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            pool_ = std::exchange(other.pool_, nullptr);
+            slab_ = other.slab_;
+        }
+
+        return *this;
+    }
+
+    inline PacketBuffer::~PacketBuffer()
+    {
+        reset();
+    }
+
+    inline char *PacketBuffer::data() const noexcept
+    {
+        return pool_ ? pool_->storage_.get() + std::size_t{slab_} * PacketBufferPool::SlabSize
+                     : nullptr;
+    }
+
+    inline std::size_t PacketBuffer::capacity() const noexcept
+    {
+        return pool_ ? PacketBufferPool::SlabSize : 0;
+    }
+
+    inline void PacketBuffer::reset() noexcept
+    {
+        if (pool_)
+        {
+            std::exchange(pool_, nullptr)->release(slab_);
+        }
+    }
+
+    inline PacketBufferPool::PacketBufferPool(std::size_t slabs_per_shard,
+                                              std::uint32_t shard_count)
+    {
+        if (slabs_per_shard == 0 || shard_count == 0)
+        {
+            throw std::invalid_argument("PacketBufferPool needs at least one slab and one shard");
+        }
+
+        slab_count_ = slabs_per_shard * shard_count;
+        headers_ = std::make_unique<SlabHeader[]>(slab_count_);
+        storage_ = std::make_unique<char[]>(slab_count_ * SlabSize);
+
+        // The free ring never holds more than the shard's own slabs, so pushes cannot fail.
+        const std::size_t ring_capacity = std::bit_ceil(std::max<std::size_t>(slabs_per_shard, 2));
+
+        shards_.reserve(shard_count);
+        for (std::uint32_t shard = 0; shard < shard_count; ++shard)
+        {
+            shards_.push_back(std::make_unique<Shard>(ring_capacity));
+
+            for (std::size_t i = 0; i < slabs_per_shard; ++i)
+            {
+                const auto slab = static_cast<std::uint32_t>(shard * slabs_per_shard + i);
+                headers_[slab].shard = shard;
+                shards_.back()->free.tryPush(slab);
+            }
+        }
+    }
+
+    inline PacketBuffer PacketBufferPool::acquire(std::uint32_t shard)
+    {
+        if (shard >= shards_.size())
+            return {};
+
+        Shard &home = *shards_[shard];
+        std::uint32_t slab = 0;
+
+        if (!home.free.tryPop(slab))
+            return {};
+
+        headers_[slab].refs.store(1, std::memory_order_relaxed);
+        home.in_use.fetch_add(1, std::memory_order_relaxed);
+
+        return PacketBuffer(this, slab);
+    }
+
+    inline std::size_t PacketBufferPool::capacity() const noexcept
+    {
+        return slab_count_;
+    }
+
+    inline std::size_t PacketBufferPool::inUse() const noexcept
+    {
+        std::size_t in_use = 0;
+
+        for (const auto &shard : shards_)
+        {
+            in_use += shard->in_use.load(std::memory_order_relaxed);
+        }
+
+        return in_use;
+    }
+
+    inline std::uint32_t PacketBufferPool::shardCount() const noexcept
+    {
+        return static_cast<std::uint32_t>(shards_.size());
+    }
+
+    inline void PacketBufferPool::retain(std::uint32_t slab) noexcept
+    {
+        headers_[slab].refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void PacketBufferPool::release(std::uint32_t slab) noexcept
+    {
+        // acq_rel: the last holder must observe every write made through other handles before
+        // the slab is handed to the receiver again.
+        if (headers_[slab].refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        Shard &home = *shards_[headers_[slab].shard];
+        home.in_use.fetch_sub(1, std::memory_order_relaxed);
+        home.free.tryPush(slab);
+    }
+} // namespace edgenetswitch
@@ -1,10 +1,87 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <string_view>
 
 #include "edgenetswitch/packet/Packet.hpp"
+#include "edgenetswitch/packet/PacketBufferPool.hpp"
+#include "edgenetswitch/switching/MacAddress.hpp"
 
 namespace edgenetswitch
 {
-    Packet parsePacket(const std::string &data);
+    // Binary ingress format, selected by a first byte that no text datagram can start with.
+    // All integers are big-endian; the payload follows the fixed header.
+    //
+    //   offset  size  field
+    //        0     1  magic (BINARY_PACKET_MAGIC)
+    //        1     1  version (BINARY_PACKET_VERSION)
+    //        2     2  flags (BINARY_FLAG_*)
+    //        4     8  id
+    //       12     6  source MAC
+    //       18     6  destination MAC
+    //       24     4  ingress port
+    //       28     2  payload length; must match the bytes that follow the header
+    inline constexpr std::uint8_t BINARY_PACKET_MAGIC = 0xE5;
+    inline constexpr std::uint8_t BINARY_PACKET_VERSION = 1;
+    inline constexpr std::size_t BINARY_PACKET_HEADER_SIZE = 30;
+
+    // Mark which optional header fields carry a value; unset fields are ignored.
+    inline constexpr std::uint16_t BINARY_FLAG_SOURCE_MAC = 1u << 0;
+    inline constexpr std::uint16_t BINARY_FLAG_DESTINATION_MAC = 1u << 1;
+    inline constexpr std::uint16_t BINARY_FLAG_INGRESS_PORT = 1u << 2;
+
+    enum class PacketParseError
+    {
+        None,
+        EmptyInput,
+        MissingId,
+        EmptyId,
+        InvalidId,
+        IdOutOfRange,
+        TruncatedHeader,
+        UnsupportedVersion,
+        PayloadLengthMismatch
+    };
+
+    // Fields of one datagram in either wire format. `payload` views the parsed input.
+    struct PacketParseResult
+    {
+        PacketParseError error{PacketParseError::None};
+        PacketWireFormat format{PacketWireFormat::Text};
+        std::uint64_t id{0};
+        std::string_view payload{};
+        std::size_t payload_offset{0}; // offset of `payload` within the parsed input
+        // Only the binary format carries these.
+        std::optional<MacAddress> source_mac{};
+        std::optional<MacAddress> destination_mac{};
+        std::optional<std::uint32_t> ingress_port{};
+
+        [[nodiscard]]
+        bool ok() const noexcept
+        {
+            return error == PacketParseError::None;
+        }
+    };
+
+    std::string toString(PacketParseError error);
+
+    // Never allocates or throws. Dispatches on the first byte: BINARY_PACKET_MAGIC selects the
+    // binary format, anything else the `id=<u64>[;payload=<bytes>]` text format. A text id must
+    // start with a decimal digit; anything after the digits up to the next ';' is ignored.
+    [[nodiscard]]
+    PacketParseResult parsePacketFields(std::string_view data) noexcept;
+
+    // Encodes the binary format from id, MACs, ingress port and payload. Throws
+    // std::length_error if the payload does not fit the 16-bit length field.
+    [[nodiscard]]
+    std::string encodeBinaryPacket(const Packet &packet);
+
+    // Sets `valid` from the parse result; the payload is copied into owned storage.
+    Packet parsePacket(std::string_view data);
+
+    // Parses the first `length` bytes of `buffer`; the payload is a view into the buffer.
+    Packet parsePacket(PacketBuffer buffer, std::size_t length);
 } // namespace edgenetswitch
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "edgenetswitch/packet/PacketBufferPool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace edgenetswitch
+{
+    // Packet payload bytes. UDP ingress binds the payload to a slice of a pooled datagram
+    // buffer, so parsing and fan-out never copy it; packets built elsewhere (control plane,
+    // generators, tests) own a std::string instead. Either way it reads as a string_view.
+    class PacketPayload
+    {
+    public:
+        PacketPayload() = default;
+
+        PacketPayload(std::string text) : owned_(std::move(text)) {}
+
+        PacketPayload(const char *text) : owned_(text) {}
+
+        PacketPayload(PacketBuffer buffer, std::size_t offset, std::size_t length) noexcept
+            : buffer_(std::move(buffer)), offset_(static_cast<std::uint32_t>(offset)),
+              length_(static_cast<std::uint32_t>(length))
+        {
+        }
+
+        [[nodiscard]]
+        std::string_view view() const noexcept
+        {
+            if (buffer_.valid())
+                return {buffer_.data() + offset_, length_};
+
+            return owned_;
+        }
+
+        operator std::string_view() const noexcept
+        {
+            return view();
+        }
+
+        [[nodiscard]]
+        const char *data() const noexcept
+        {
+            return view().data();
+        }
+
+        [[nodiscard]]
+        std::size_t size() const noexcept
+        {
+            return buffer_.valid() ? length_ : owned_.size();
+        }
+
+        [[nodiscard]]
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        [[nodiscard]]
+        std::string_view::const_iterator begin() const noexcept
+        {
+            return view().begin();
+        }
+
+        [[nodiscard]]
+        std::string_view::const_iterator end() const noexcept
+        {
+            return view().end();
+        }
+
+        [[nodiscard]]
+        bool pooled() const noexcept
+        {
+            return buffer_.valid();
+        }
+
+        [[nodiscard]]
+        std::string str() const
+        {
+            return std::string(view());
+        }
+
+        // Copies a pooled payload into owned storage and drops the slab reference, for
+        // holders that keep packets beyond their lifecycle (e.g. replay recording).
+        void detach()
+        {
+            if (!buffer_.valid())
+                return;
+
+            owned_.assign(view());
+            buffer_.reset();
+            offset_ = 0;
+            length_ = 0;
+        }
+
+        friend bool operator==(const PacketPayload &lhs, std::string_view rhs) noexcept
+        {
+            return lhs.view() == rhs;
+        }
+
+    private:
+        PacketBuffer buffer_;
+        std::uint32_t offset_{0};
+        std::uint32_t length_{0};
+        std::string owned_;
+    };
+} // namespace edgenetswitch
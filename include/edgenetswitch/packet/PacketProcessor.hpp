@@ -1,19 +1,27 @@
 #pragma once
 
+#include "edgenetswitch/core/BoundedRing.hpp"
 #include "edgenetswitch/failure/FailureInjector.hpp"
 #include "edgenetswitch/messaging/MessagingBus.hpp"
 #include "edgenetswitch/packet/Packet.hpp"
+#include "edgenetswitch/packet/PacketWorkerLimits.hpp"
 #include "edgenetswitch/switching/SwitchForwardingEngine.hpp"
 #include "edgenetswitch/transport/TransportManager.hpp"
 #include <atomic>
-#include <condition_variable>
 #include <cstddef>
-#include <deque>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace edgenetswitch
 {
+    // Flow key used for worker affinity: (ingress_port, source_mac) when both are known,
+    // otherwise (source_ipv4, source_port). Packets of one flow always map to one worker.
+    [[nodiscard]]
+    std::uint64_t packetFlowHash(const Packet &packet) noexcept;
+
     class PacketProcessor
     {
     public:
@@ -21,24 +29,62 @@ namespace edgenetswitch
                                  SwitchForwardingEngine *forwarding_engine = nullptr,
                                  transport::TransportManager *transport_manager = nullptr,
                                  failure::FailureInjector injector = failure::FailureInjector{
-                                     failure::FailureConfig{}});
+                                     failure::FailureConfig{}},
+                                 std::uint32_t worker_count = 1,
+                                 RingProducerMode producer_mode = RingProducerMode::Multi);
         ~PacketProcessor();
-        void processLoop();
         void processPacket(Packet processedPacket);
         void handleInjectedFailure(const Packet &pkt, const failure::FailureResult &failure,
                                    std::uint64_t now_ms);
 
+        // Runs MAC aging under the same lock as forwarding; safe to call from the tick loop.
+        // The lock is released every MAC_AGE_BATCH expirations so workers are never stalled
+        // by a large expiry, and at most MAC_AGE_TICK_BUDGET entries are removed per call;
+        // the rest are picked up on later ticks.
+        void ageMacTable(std::uint64_t now_tick, std::uint64_t max_age);
+
+        [[nodiscard]]
+        std::uint32_t workerCount() const noexcept;
+
+        [[nodiscard]]
+        std::uint32_t workerFor(const Packet &packet) const noexcept;
+
     private:
-        std::deque<Packet> queue_;
-        std::mutex queue_mutex_;
-        std::condition_variable cv_;
-        std::thread worker_;
-        std::atomic<bool> running_{true};
         static constexpr size_t MAX_QUEUE_SIZE = 1024;
+        static constexpr std::size_t MAC_AGE_BATCH = 256;
+        static constexpr std::size_t MAC_AGE_TICK_BUDGET = 16384;
+        // Empty polls before a worker parks; covers short gaps inside a burst.
+        static constexpr int SPIN_BEFORE_PARK = 256;
+        static constexpr std::size_t CacheLine = 64;
+
+        // One bounded ring and thread per worker. Spin-then-park handshake: producers only
+        // touch wake_epoch when the worker has announced that it is about to sleep.
+        struct alignas(CacheLine) Worker
+        {
+            Worker(std::uint32_t worker_id, RingProducerMode producer_mode)
+                : id(worker_id), queue(MAX_QUEUE_SIZE, producer_mode)
+            {
+            }
+
+            std::uint32_t id{0};
+            BoundedRing<Packet> queue;
+            std::thread thread;
+            std::atomic<bool> parked{false};
+            std::atomic<std::uint32_t> wake_epoch{0};
+        };
+
+        void processLoop(Worker &worker);
+        bool waitForPacket(Worker &worker, Packet &packet);
+        void wakeWorker(Worker &worker);
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::atomic<bool> running_{true};
         static constexpr std::size_t MAX_PAYLOAD_SIZE = 512;
         MessagingBus &bus_;
         failure::FailureInjector injector_;
         SwitchForwardingEngine *forwarding_engine_{nullptr};
         transport::TransportManager *transport_manager_{nullptr};
+        // MacTable accepts one writer at a time; serializes MAC learning across workers and aging.
+        std::mutex forwarding_mutex_;
     };
 } // namespace edgenetswitch
@@ -1,23 +1,81 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <unordered_map>
-#include <unordered_set>
+#include <memory>
 #include <mutex>
 
+#include "edgenetswitch/core/ShardedCounters.hpp"
+#include "edgenetswitch/packet/LifecycleDedupWindow.hpp"
 #include "edgenetswitch/packet/Packet.hpp"
+#include "edgenetswitch/packet/PacketBufferPool.hpp"
 #include "edgenetswitch/messaging/MessagingBus.hpp"
+#include "edgenetswitch/network/UdpReceiverLimits.hpp"
+#include "edgenetswitch/packet/PacketWorkerLimits.hpp"
+#include "edgenetswitch/packet/PipelineStamps.hpp"
+#include "edgenetswitch/telemetry/LatencyHistogram.hpp"
 
 namespace edgenetswitch
 {
+    // Power-of-two buckets for recvmmsg batch sizes: [1], [2,3], [4,7], ... [128,+).
+    inline constexpr std::size_t UDP_BATCH_HISTOGRAM_BUCKETS = 8;
+
+    using UdpBatchHistogram = std::array<std::uint64_t, UDP_BATCH_HISTOGRAM_BUCKETS>;
+
+    [[nodiscard]]
+    std::size_t udpBatchHistogramBucket(std::uint32_t datagram_count) noexcept;
+
+    // Drop counts indexed by dropReasonIndex(); a fixed array, so snapshots never allocate.
+    using PacketDropCounts = std::array<std::uint64_t, PACKET_DROP_REASON_COUNT>;
+
+    // The index helpers keep out-of-range values (a bad cast) inside the arrays: an unknown
+    // reason is counted as Unknown and an unknown source as Ingress, the PacketDropped default.
+    [[nodiscard]]
+    constexpr std::size_t dropReasonIndex(PacketDropReason reason) noexcept
+    {
+        const auto index = static_cast<std::size_t>(reason);
+        return index < PACKET_DROP_REASON_COUNT
+                   ? index
+                   : static_cast<std::size_t>(PacketDropReason::Unknown);
+    }
+
+    [[nodiscard]]
+    constexpr std::size_t dropSourceIndex(PacketDropSource source) noexcept
+    {
+        const auto index = static_cast<std::size_t>(source);
+        return index < PACKET_DROP_SOURCE_COUNT
+                   ? index
+                   : static_cast<std::size_t>(PacketDropSource::Ingress);
+    }
+
+    struct UdpReceiverMetrics
+    {
+        std::uint64_t ingress_packets{0};
+        std::uint64_t drain_completions{0};
+        std::uint64_t batches{0};
+    };
+
+    // Latency is measured from PacketProcessor admission to PacketProcessed publication.
+    struct PacketWorkerMetrics
+    {
+        std::uint64_t processed_packets{0};
+        std::uint64_t drops{0};
+        std::uint64_t queue_overflow_drops{0};
+        std::uint64_t average_latency_ns{0};
+        std::uint64_t max_latency_ns{0};
+    };
+
     struct PacketMetrics
     {
         std::uint64_t rx_packets{0};
         std::uint64_t rx_bytes{0};
         std::uint64_t rx_packets_per_sec{0};
         std::uint64_t rx_bytes_per_sec{0};
-        std::unordered_map<PacketDropReason, std::uint64_t> drops_by_reason;
+        PacketDropCounts drops_by_reason{};
+        // The same drops split by the component that published them; rows sum to drops_by_reason.
+        std::array<PacketDropCounts, PACKET_DROP_SOURCE_COUNT> drops_by_source{};
         std::uint64_t rx_packets_per_sec_raw{0};
         std::uint64_t rx_bytes_per_sec_raw{0};
         std::uint64_t ingress_packets{0};
@@ -25,21 +83,58 @@ namespace edgenetswitch
         std::uint64_t processing_gap{0};
         std::uint64_t terminal_events{0};
         std::uint64_t duplicate_events{0};
+        // Terminal events counted without a duplicate check because their lifecycle_id was
+        // older than the dedup window (LifecycleDedupWindow::Span).
+        std::uint64_t stale_lifecycle_events{0};
         std::uint64_t pending_terminal_events{0};
         std::uint64_t total_processing_latency_ns{0};
         std::uint64_t max_processing_latency_ns{0};
         std::uint64_t average_processing_latency_ns{0};
         std::uint64_t latency_samples{0};
+        // Ingress-to-processed latency since start.
+        LatencyPercentiles processing_latency;
+        // Time spent in each PipelineStage by processed UDP packets, since start.
+        std::array<LatencyPercentiles, PIPELINE_STAGE_COUNT> stage_latency{};
         std::uint64_t udp_drain_completions{0};
+        std::uint64_t udp_batches{0};
+        UdpBatchHistogram udp_batch_histogram{};
+        std::uint32_t udp_receiver_count{0}; // receivers that have reported ingress activity
+        std::array<UdpReceiverMetrics, MAX_UDP_RECEIVERS> udp_receivers{};
+        std::uint32_t packet_worker_count{0}; // workers that have reported processing activity
+        std::array<PacketWorkerMetrics, MAX_PACKET_WORKERS> packet_workers{};
+        std::uint64_t buffer_pool_capacity{0}; // 0 when ingress payloads are not pooled
+        std::uint64_t buffer_pool_in_use{0};
+    };
+
+    // Ingress-to-processed latency recorded since the previous reset-on-read call.
+    struct LatencyWindow
+    {
+        LatencyPercentiles latency;
+        std::uint64_t window_ms{0}; // 0 for the first read, which covers everything since start
     };
 
     class PacketStats
     {
     public:
-        explicit PacketStats(MessagingBus &bus);
+        // `buffer_pool`, when given, must outlive the stats; its occupancy is sampled on snapshot.
+        // `lifecycle_id_stride` is the number of UdpReceivers interleaving lifecycle ids (see
+        // LifecycleIdGenerator); each one's sequence is deduplicated in its own window.
+        explicit PacketStats(MessagingBus &bus, const PacketBufferPool *buffer_pool = nullptr,
+                             std::uint32_t lifecycle_id_stride = 1);
 
         PacketMetrics snapshotAt(std::uint64_t now_ms) const;
 
+        // Cumulative ingress-to-processed latency, merged across every recording worker.
+        LatencyDistribution processingLatency() const;
+
+        // Reset-on-read: percentiles of what was recorded since the previous call, which
+        // becomes the baseline for the next one. Every caller shares one window, so two
+        // readers polling independently split the samples between them.
+        LatencyWindow takeProcessingLatencyWindow(std::uint64_t now_ms);
+
+        // Cumulative time spent in `stage`, merged across every recording worker.
+        LatencyDistribution stageLatency(PipelineStage stage) const;
+
         std::uint64_t rxPackets() const;
         std::uint64_t rxBytes() const;
         std::uint64_t drops() const;
@@ -50,19 +145,79 @@ namespace edgenetswitch
         void onTerminal(uint64_t lifecycle_id);
 
     private:
-        std::atomic<std::uint64_t> rx_packets_{0};
-        std::atomic<std::uint64_t> rx_bytes_{0};
-        std::unordered_map<PacketDropReason, std::atomic<uint64_t>> drop_counters_;
-        std::atomic<std::uint64_t> ingress_packets_{0};
-        std::atomic<std::uint64_t> processed_packets_{0};
-        std::atomic<std::uint64_t> terminal_events_{0};
-        std::atomic<std::uint64_t> duplicate_events_{0};
-        std::unordered_set<uint64_t> completed_lifecycles_;
-        mutable std::mutex lifecycle_mutex_;
-        std::atomic_uint64_t total_processing_latency_ns_{0};
+        // Receiver and worker counters are bumped by their owning thread for every packet;
+        // aligning each to a cache line keeps neighbouring owners from false sharing.
+        struct alignas(64) UdpReceiverCounters
+        {
+            std::atomic_uint64_t ingress_packets{0};
+            std::atomic_uint64_t drain_completions{0};
+            std::atomic_uint64_t batches{0};
+        };
+
+        struct alignas(64) PacketWorkerCounters
+        {
+            std::atomic_uint64_t processed_packets{0};
+            std::atomic_uint64_t drops{0};
+            std::atomic_uint64_t queue_overflow_drops{0};
+            std::atomic_uint64_t total_latency_ns{0};
+            std::atomic_uint64_t max_latency_ns{0};
+            LatencyHistogram processing_latency; // ingress-to-processed, recorded by this worker
+        };
+
+        // Records a terminal event; false when it repeats an already completed lifecycle.
+        bool completeLifecycle(std::uint64_t lifecycle_id);
+        using StageHistograms = std::array<LatencyHistogram, PIPELINE_STAGE_COUNT>;
+
+        // Drops are bumped by the receivers, the workers and the failure injector at once;
+        // one cache line per (source, reason) keeps them from contending.
+        struct alignas(64) DropCounter
+        {
+            std::atomic_uint64_t value{0};
+        };
+
+        using DropCounterRow = std::array<DropCounter, PACKET_DROP_REASON_COUNT>;
+
+        UdpReceiverCounters *receiverCounters(std::uint32_t receiver_id);
+        PacketWorkerCounters *workerCounters(std::optional<std::uint32_t> worker_id);
+
+        // Sums bumped once or more per packet, sharded per thread (see ShardedCounters).
+        enum Counter : std::size_t
+        {
+            RxPackets,
+            RxBytes,
+            IngressPackets,
+            ProcessedPackets,
+            TerminalEvents,
+            DuplicateEvents,
+            StaleLifecycleEvents,
+            TotalProcessingLatencyNs,
+            LatencySamples,
+            UdpDrainCompletions,
+            UdpBatches,
+            UdpBatchHistogramFirst,
+            CounterCount = UdpBatchHistogramFirst + UDP_BATCH_HISTOGRAM_BUCKETS
+        };
+
+        ShardedCounters<CounterCount> counters_;
+        std::array<DropCounterRow, PACKET_DROP_SOURCE_COUNT> drop_counters_{};
+        // One window per receiver id sequence: window id % stride holds id / stride, so a busy
+        // receiver running ahead cannot push an idle one's ids out of the window.
+        std::uint32_t lifecycle_id_stride_{1};
+        std::unique_ptr<LifecycleDedupWindow[]> completed_lifecycles_;
         std::atomic_uint64_t max_processing_latency_ns_{0};
-        std::atomic_uint64_t latency_samples_{0};
-        std::atomic_uint64_t udp_drain_completions_{0};
+        LatencyHistogram unattributed_latency_; // packets published without a processor_worker
+        std::mutex latency_window_mutex_;
+        LatencyDistribution latency_window_baseline_;
+        std::uint64_t latency_window_start_ms_{0};
+        bool latency_window_started_{false};
+        // One set per worker plus a last one for packets without a processor_worker. Kept on
+        // the heap: at 8 KiB per histogram it would otherwise dominate the object.
+        std::unique_ptr<StageHistograms[]> stage_latency_;
+        std::atomic_uint32_t udp_receiver_count_{0};
+        std::array<UdpReceiverCounters, MAX_UDP_RECEIVERS> udp_receivers_{};
+        std::atomic_uint32_t packet_worker_count_{0};
+        std::array<PacketWorkerCounters, MAX_PACKET_WORKERS> packet_workers_{};
+        const PacketBufferPool *buffer_pool_{nullptr};
     };
 
 } // namespace edgenetswitch
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "edgenetswitch/packet/Packet.hpp"
 
@@ -12,7 +13,8 @@ namespace edgenetswitch
         InvalidFormat,
         EmptyPayload,
         MissingSource,
-        PayloadTooLarge
+        PayloadTooLarge,
+        NonPrintablePayload
     };
 
     struct ValidationResult
@@ -23,9 +25,43 @@ namespace edgenetswitch
 
     std::string toString(PacketRejectReason reason);
 
+    // Result of one pass over the payload bytes. Whitespace is the "C" locale set
+    // (space, \t, \n, \v, \f, \r); a control byte is any other byte below 0x20, or 0x7F.
+    // Bytes of 0x80 and above count as printable so UTF-8 text passes.
+    struct PayloadScan
+    {
+        bool all_whitespace{true}; // also true for an empty payload
+        bool has_control{false};
+    };
+
+    enum class PayloadScanKernel
+    {
+        Scalar,
+        Sse2,
+        Avx2
+    };
+
+    std::string toString(PayloadScanKernel kernel);
+
+    [[nodiscard]]
+    bool payloadScanKernelSupported(PayloadScanKernel kernel) noexcept;
+
+    // Widest kernel the running CPU supports, detected once.
+    [[nodiscard]]
+    PayloadScanKernel activePayloadScanKernel() noexcept;
+
+    [[nodiscard]]
+    PayloadScan scanPayload(std::string_view payload) noexcept;
+
+    // Runs a specific kernel; falls back to Scalar if the CPU does not support it.
+    [[nodiscard]]
+    PayloadScan scanPayload(std::string_view payload, PayloadScanKernel kernel) noexcept;
+
     class PacketValidator
     {
     public:
+        // Binary-format packets skip the printable check; for them only a zero-length payload
+        // counts as empty.
         static ValidationResult validate(const Packet &packet);
     };
 
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+
+namespace edgenetswitch
+{
+    // Upper bound on PacketProcessor worker threads; sizes the per-worker counter arrays.
+    inline constexpr std::size_t MAX_PACKET_WORKERS = 16;
+} // namespace edgenetswitch
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "edgenetswitch/core/CycleClock.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+namespace edgenetswitch
+{
+    // Pipeline stages in packet order; each one ends where the next begins.
+    enum class PipelineStage : std::uint8_t
+    {
+        ParseValidate, // UdpReceiver: datagram handed over -> parsed and validated
+        Echo,          // UdpReceiver: echo sendto() back to the client
+        BusPublish,    // PacketRx publish, observers and admission -> queued on a worker
+        QueueWait,     // worker ring -> picked up by the worker
+        Switching,     // SwitchForwardingEngine::processPacket, including the forwarding lock
+        Transport      // TransportManager::transmit to every egress port
+    };
+
+    inline constexpr std::size_t PIPELINE_STAGE_COUNT =
+        static_cast<std::size_t>(PipelineStage::Transport) + 1;
+
+    inline const char *toString(PipelineStage stage)
+    {
+        switch (stage)
+        {
+        case PipelineStage::ParseValidate:
+            return "parse_validate";
+        case PipelineStage::Echo:
+            return "echo";
+        case PipelineStage::BusPublish:
+            return "bus_publish";
+        case PipelineStage::QueueWait:
+            return "queue_wait";
+        case PipelineStage::Switching:
+            return "switching";
+        case PipelineStage::Transport:
+            return "transport";
+        }
+
+        return "unknown";
+    }
+
+    // Per-packet stage timestamps: one CycleClock base taken when the receiver picks the
+    // datagram up, and the end of each stage as a 32-bit tick offset from it (0 = not reached;
+    // offsets saturate after 2^32 ticks, about a second on a GHz TSC). Packets that did not
+    // come through a UdpReceiver are never started and mark() ignores them.
+    class PipelineStamps
+    {
+    public:
+        void start(std::uint64_t now_ticks = CycleClock::now()) noexcept
+        {
+            base_ = now_ticks;
+            ends_ = {};
+        }
+
+        [[nodiscard]]
+        bool started() const noexcept
+        {
+            return base_ != 0;
+        }
+
+        void mark(PipelineStage stage) noexcept
+        {
+            if (!started())
+                return;
+
+            const std::uint64_t elapsed = CycleClock::now() - base_;
+            ends_[static_cast<std::size_t>(stage)] = static_cast<std::uint32_t>(
+                elapsed < MaxOffset ? (elapsed == 0 ? 1 : elapsed) : MaxOffset);
+        }
+
+        // Time spent in `stage`, or nullopt when the packet did not pass through it.
+        [[nodiscard]]
+        std::optional<std::uint64_t> stageNs(PipelineStage stage) const noexcept
+        {
+            const auto index = static_cast<std::size_t>(stage);
+            const std::uint32_t end = ends_[index];
+            const std::uint32_t begin = index == 0 ? 0 : ends_[index - 1];
+
+            if (!started() || end == 0 || (index != 0 && begin == 0) || end < begin)
+                return std::nullopt;
+
+            return CycleClock::toNs(end - begin);
+        }
+
+    private:
+        static constexpr std::uint64_t MaxOffset = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint64_t base_{0};
+        std::array<std::uint32_t, PIPELINE_STAGE_COUNT> ends_{};
+    };
+} // namespace edgenetswitch
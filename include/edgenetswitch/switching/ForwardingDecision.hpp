@@ -1,7 +1,8 @@
 #pragma once
 
+#include "edgenetswitch/switching/PortSet.hpp"
+
 #include <cstdint>
-#include <vector>
 
 namespace edgenetswitch
 {
@@ -16,6 +17,6 @@ namespace edgenetswitch
     {
         ForwardingAction action{ForwardingAction::Drop};
 
-        std::vector<std::uint32_t> egress_ports{};
+        PortSet egress_ports{};
     };
 } // namespace edgenetswitch
\ No newline at end of file
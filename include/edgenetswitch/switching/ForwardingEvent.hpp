@@ -1,9 +1,9 @@
 #pragma once
 
 #include "edgenetswitch/switching/ForwardingDecision.hpp"
+#include "edgenetswitch/switching/PortSet.hpp"
 
 #include <cstdint>
-#include <vector>
 
 namespace edgenetswitch
 {
@@ -11,6 +11,6 @@ namespace edgenetswitch
     {
         std::uint64_t lifecycle_id{0};
         ForwardingAction action{ForwardingAction::Drop};
-        std::vector<std::uint32_t> egress_ports{};
+        PortSet egress_ports{};
     };
 } // namespace edgenetswitch
\ No newline at end of file
@@ -1,34 +1,49 @@
 #pragma once
 
+#include "edgenetswitch/switching/PortSet.hpp"
 #include "edgenetswitch/switching/SwitchPort.hpp"
 
 #include <cstdint>
-#include <map>
 #include <optional>
 #include <vector>
 
 namespace edgenetswitch
 {
+    // Dense registry indexed directly by port id (ids below MAX_SWITCH_PORTS). The set of Up
+    // ports and, for every possible ingress, the flood set excluding that ingress are
+    // precomputed on addPort()/setState(), so the forwarding path never walks the ports.
     class InterfaceRegistry
     {
     public:
+        InterfaceRegistry();
+
+        // Throws std::out_of_range if the port id is not below MAX_SWITCH_PORTS.
         void addPort(SwitchPort port);
 
         [[nodiscard]]
         std::optional<SwitchPort> findPort(std::uint32_t port_id) const;
 
         [[nodiscard]]
-        bool isUp(std::uint32_t port_id) const;
+        bool isUp(std::uint32_t port_id) const noexcept;
 
         void setState(std::uint32_t port_id, PortState state);
 
         [[nodiscard]]
         std::vector<std::uint32_t> activePortIds() const;
 
+        // Up ports other than `ingress_port`.
+        [[nodiscard]]
+        const PortSet &floodSet(std::uint32_t ingress_port) const noexcept;
+
         [[nodiscard]]
         std::vector<SwitchPort> snapshot() const;
 
     private:
-        std::map<std::uint32_t, SwitchPort> ports_;
+        void rebuildFloodSets() noexcept;
+
+        std::vector<std::optional<SwitchPort>> ports_;
+        PortSet registered_;
+        PortSet up_ports_;
+        std::vector<PortSet> flood_sets_;
     };
-} // namespace edgenetswitch
\ No newline at end of file
+} // namespace edgenetswitch
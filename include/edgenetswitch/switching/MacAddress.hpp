@@ -17,9 +17,13 @@ namespace edgenetswitch
         explicit MacAddress(Bytes bytes);
 
         [[nodiscard]] static std::optional<MacAddress> fromString(std::string_view text);
+        // Inverse of packed(); bits above 47 are ignored.
+        [[nodiscard]] static MacAddress fromPacked(std::uint64_t packed) noexcept;
 
         [[nodiscard]] std::string toString() const;
         [[nodiscard]] const Bytes &bytes() const noexcept;
+        // Big-endian 48-bit value in the low bits; preserves the byte-wise ordering.
+        [[nodiscard]] std::uint64_t packed() const noexcept;
 
         [[nodiscard]] bool isBroadcast() const noexcept;
         [[nodiscard]] bool isZero() const noexcept;
@@ -1,13 +1,34 @@
+#pragma once
+
 #include "edgenetswitch/switching/MacAddress.hpp"
 #include "edgenetswitch/switching/MacTableEntry.hpp"
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 
 namespace edgenetswitch
 {
+    // Open-addressing (linear probing) table keyed on the packed 48-bit MAC. Entries live
+    // inline in one power-of-two slot array sized for a load factor of at most 2/3, and
+    // removals use backward-shift deletion so probe chains never accumulate tombstones.
+    //
+    // Occupied slots are also threaded on an intrusive LRU list (slot indices), so learning a
+    // new MAC on a full table evicts the least recently learned entry in O(1).
+    //
+    // Aging uses a hierarchical timing wheel keyed on last_seen_tick (64 buckets per level,
+    // 6 tick bits per level). ageOut() visits only buckets that hold entries due before the
+    // cutoff, so its cost follows the number of expirations rather than the table size. A
+    // caller can cap the expirations per call; due entries left over stay on the wheel and
+    // are removed by the next call.
+    //
+    // Concurrency: one writer at a time (learn/ageOut), any number of concurrent readers
+    // (lookup/snapshot/size/evictions). The slot array is split into 64-slot shards, each with
+    // a version counter the writer holds odd while it changes that shard. Readers never take a
+    // lock or block the writer; a lookup retries only if a shard it probed changed under it.
     class MacTable
     {
     public:
@@ -18,8 +39,16 @@ namespace edgenetswitch
         [[nodiscard]]
         std::optional<std::uint32_t> lookup(const MacAddress &mac) const;
 
-        void ageOut(std::uint64_t current_tick, std::uint64_t max_age);
+        static constexpr std::size_t UnboundedExpirations = ~std::size_t{0};
+
+        // Removes entries with current_tick - last_seen_tick > max_age, at most max_expirations
+        // of them. Returns the number removed.
+        std::size_t ageOut(std::uint64_t current_tick, std::uint64_t max_age,
+                           std::size_t max_expirations = UnboundedExpirations);
 
+        // Sorted by MAC address. Each shard is copied consistently; if learning keeps moving
+        // entries across shards for several passes, the dump may omit an entry that was being
+        // relocated at that moment.
         [[nodiscard]]
         std::vector<MacTableEntry> snapshot() const;
 
@@ -29,8 +58,88 @@ namespace edgenetswitch
         [[nodiscard]]
         std::size_t capacity() const noexcept;
 
+        // Entries removed to make room for a new MAC; aging removals are not counted.
+        [[nodiscard]]
+        std::uint64_t evictions() const noexcept;
+
     private:
+        // Packed MACs use 48 bits, so an all-ones key can never collide with a real address.
+        static constexpr std::uint64_t EmptyKey = ~std::uint64_t{0};
+        static constexpr std::uint32_t NoSlot = ~std::uint32_t{0};
+
+        static constexpr unsigned WheelBits = 6;
+        static constexpr std::size_t WheelSlots = std::size_t{1} << WheelBits;
+        // 11 levels x 6 bits cover the full 64-bit tick range.
+        static constexpr std::size_t WheelLevels = 11;
+        // Entries learned with a tick the wheel cursor has already passed.
+        static constexpr std::uint16_t OverdueBucket = WheelLevels * WheelSlots;
+
+        static constexpr unsigned ShardBits = 6;
+        static constexpr std::size_t ShardSlots = std::size_t{1} << ShardBits;
+        static constexpr int SnapshotPasses = 4;
+
+        // Reader-visible part of a slot. Only the writer stores; readers load relaxed and
+        // validate against the shard version.
+        struct Cell
+        {
+            std::atomic<std::uint64_t> key{EmptyKey};
+            std::atomic<std::uint64_t> last_seen_tick{0};
+            std::atomic<std::uint32_t> port_id{0};
+        };
+
+        // Writer-private bookkeeping, parallel to the cells.
+        struct Links
+        {
+            std::uint32_t newer{NoSlot}; // towards lru_head_
+            std::uint32_t older{NoSlot}; // towards lru_tail_
+            std::uint32_t wheel_prev{NoSlot};
+            std::uint32_t wheel_next{NoSlot};
+            std::uint16_t wheel_bucket{0};
+        };
+
+        class ShardReadSet;
+
+        [[nodiscard]]
+        std::size_t home(std::uint64_t key) const noexcept;
+
+        [[nodiscard]]
+        std::size_t find(std::uint64_t key) const noexcept;
+
+        [[nodiscard]]
+        std::uint64_t keyAt(std::size_t index) const noexcept;
+
+        [[nodiscard]]
+        std::uint64_t tickAt(std::size_t index) const noexcept;
+
+        void storeCell(std::size_t index, std::uint64_t key, std::uint64_t tick,
+                       std::uint32_t port_id) noexcept;
+        void openShard(std::size_t index) noexcept;
+        void closeShards() noexcept;
+
+        void eraseAt(std::size_t index) noexcept;
+        void moveSlot(std::size_t from, std::size_t to) noexcept;
+        void unlink(std::size_t index) noexcept;
+        void pushFront(std::size_t index) noexcept;
+        void wheelInsert(std::size_t index) noexcept;
+        void wheelRemove(std::size_t index) noexcept;
+        std::size_t expireBefore(std::uint64_t cutoff_tick, std::size_t max_expirations);
+
         std::size_t capacity_{0};
-        std::map<MacAddress, MacTableEntry> entries_;
+        std::atomic<std::size_t> size_{0};
+        std::size_t slot_count_{0};
+        std::size_t mask_{0};
+        unsigned shift_{64};
+        std::unique_ptr<Cell[]> cells_;
+        std::vector<Links> links_;
+        std::unique_ptr<std::atomic<std::uint32_t>[]> shard_versions_;
+        std::vector<std::uint32_t> open_shards_; // odd-versioned by the current write
+        std::uint32_t lru_head_{NoSlot}; // most recently learned
+        std::uint32_t lru_tail_{NoSlot}; // next eviction candidate
+        std::atomic<std::uint64_t> evictions_{0};
+        // Every entry with last_seen_tick < wheel_now_ has been expired or sits in the
+        // overdue bucket.
+        std::uint64_t wheel_now_{0};
+        std::array<std::uint32_t, OverdueBucket + 1> wheel_heads_;
+        std::array<std::uint64_t, WheelLevels> wheel_occupied_{};
     };
-} // namespace edgenetswitch
\ No newline at end of file
+} // namespace edgenetswitch
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "edgenetswitch/switching/SwitchPortLimits.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+
+namespace edgenetswitch
+{
+    // Fixed-capacity set of port ids backed by an inline bitmap, so building, copying and
+    // iterating an egress set never touches the heap. Iteration yields ids in ascending order.
+    class PortSet
+    {
+    public:
+        static constexpr std::size_t WordBits = 64;
+        static constexpr std::size_t WordCount = (MAX_SWITCH_PORTS + WordBits - 1) / WordBits;
+
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::uint32_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::uint32_t;
+
+            Iterator() = default;
+
+            std::uint32_t operator*() const noexcept
+            {
+                const auto bit = static_cast<std::size_t>(std::countr_zero(bits_));
+                return static_cast<std::uint32_t>(word_ * WordBits + bit);
+            }
+
+            Iterator &operator++() noexcept
+            {
+                bits_ &= bits_ - 1;
+                settle();
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept
+            {
+                Iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            friend bool operator==(const Iterator &lhs, const Iterator &rhs) noexcept
+            {
+                return lhs.word_ == rhs.word_ && lhs.bits_ == rhs.bits_;
+            }
+
+        private:
+            friend class PortSet;
+
+            Iterator(const std::array<std::uint64_t, WordCount> *words, std::size_t word) noexcept
+                : words_(words), word_(word), bits_(word < WordCount ? (*words)[word] : 0)
+            {
+                settle();
+            }
+
+            // Advances to the next non-empty word; the end iterator is (WordCount, 0).
+            void settle() noexcept
+            {
+                while (bits_ == 0 && word_ < WordCount)
+                {
+                    ++word_;
+                    bits_ = word_ < WordCount ? (*words_)[word_] : 0;
+                }
+            }
+
+            const std::array<std::uint64_t, WordCount> *words_{nullptr};
+            std::size_t word_{WordCount};
+            std::uint64_t bits_{0};
+        };
+
+        PortSet() = default;
+
+        PortSet(std::initializer_list<std::uint32_t> ports) noexcept
+        {
+            for (const std::uint32_t port : ports)
+            {
+                insert(port);
+            }
+        }
+
+        // Ids at or above MAX_SWITCH_PORTS are ignored; InterfaceRegistry never admits them.
+        void insert(std::uint32_t port) noexcept
+        {
+            if (port < MAX_SWITCH_PORTS)
+                words_[port / WordBits] |= std::uint64_t{1} << (port % WordBits);
+        }
+
+        void erase(std::uint32_t port) noexcept
+        {
+            if (port < MAX_SWITCH_PORTS)
+                words_[port / WordBits] &= ~(std::uint64_t{1} << (port % WordBits));
+        }
+
+        [[nodiscard]]
+        bool contains(std::uint32_t port) const noexcept
+        {
+            return port < MAX_SWITCH_PORTS &&
+                   (words_[port / WordBits] >> (port % WordBits) & 1u) != 0;
+        }
+
+        [[nodiscard]]
+        std::size_t size() const noexcept
+        {
+            std::size_t count = 0;
+            for (const std::uint64_t word : words_)
+            {
+                count += static_cast<std::size_t>(std::popcount(word));
+            }
+            return count;
+        }
+
+        [[nodiscard]]
+        bool empty() const noexcept
+        {
+            for (const std::uint64_t word : words_)
+            {
+                if (word != 0)
+                    return false;
+            }
+            return true;
+        }
+
+        void clear() noexcept
+        {
+            words_.fill(0);
+        }
+
+        [[nodiscard]]
+        Iterator begin() const noexcept
+        {
+            return Iterator(&words_, 0);
+        }
+
+        [[nodiscard]]
+        Iterator end() const noexcept
+        {
+            return Iterator(&words_, WordCount);
+        }
+
+        friend bool operator==(const PortSet &lhs, const PortSet &rhs) noexcept
+        {
+            return lhs.words_ == rhs.words_;
+        }
+
+    private:
+        std::array<std::uint64_t, WordCount> words_{};
+    };
+} // namespace edgenetswitch
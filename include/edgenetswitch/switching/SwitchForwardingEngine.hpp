@@ -4,6 +4,7 @@
 #include "edgenetswitch/switching/ForwardingDecision.hpp"
 #include "edgenetswitch/switching/InterfaceRegistry.hpp"
 #include "edgenetswitch/switching/MacTable.hpp"
+#include <cstddef>
 #include <cstdint>
 
 namespace edgenetswitch
@@ -17,6 +18,9 @@ namespace edgenetswitch
         ForwardingDecision processPacket(const Packet &packet, std::uint32_t ingress_port,
                                          std::uint64_t tick);
 
+        std::size_t ageMacTable(std::uint64_t tick, std::uint64_t max_age,
+                                std::size_t max_expirations = MacTable::UnboundedExpirations);
+
         const MacTable &macTable() const noexcept;
 
     private:
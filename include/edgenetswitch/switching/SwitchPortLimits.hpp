@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+
+namespace edgenetswitch
+{
+    // Port ids must be below this bound; sizes the egress PortSet bitmap.
+    inline constexpr std::uint32_t MAX_SWITCH_PORTS = 256;
+} // namespace edgenetswitch
@@ -3,6 +3,8 @@
 #include "edgenetswitch/system/fd/FdState.hpp"
 #include "edgenetswitch/system/fd/FdType.hpp"
 
+#include <string>
+
 namespace edgenetswitch
 {
     struct FdRecord
@@ -10,5 +12,6 @@ namespace edgenetswitch
         int fd{-1};
         FdState state{FdState::Invalid};
         FdType fd_type{FdType::Unknown};
+        std::string label{}; // optional owner tag, e.g. "udp-rx-0"
     };
 } // namespace edgenetswitch
\ No newline at end of file
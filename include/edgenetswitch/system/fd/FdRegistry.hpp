@@ -5,6 +5,7 @@
 #include "edgenetswitch/system/fd/FdType.hpp"
 
 #include <mutex>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -17,6 +18,8 @@ namespace edgenetswitch
 
         void updateState(int fd, FdState state);
 
+        void setLabel(int fd, std::string label);
+
         void unregisterFd(int fd);
 
         [[nodiscard]]
@@ -25,6 +28,5 @@ namespace edgenetswitch
     private:
         mutable std::mutex mutex_;
         std::unordered_map<int, FdRecord> records_;
-        
     };
 } // namespace edgenetswitch
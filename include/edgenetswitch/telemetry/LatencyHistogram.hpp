@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace edgenetswitch
+{
+    // Log-linear latency buckets in the HdrHistogram layout: values below 64 ns get one bucket
+    // each, and every power of two above that is split into 32 linear sub-buckets, so a bucket
+    // is never wider than 1/32 (about 3%) of the values it holds. Values at or above 2^36 ns
+    // (about 69 s) share the last bucket.
+    inline constexpr unsigned LATENCY_HISTOGRAM_SUB_BUCKET_BITS = 5;
+    inline constexpr unsigned LATENCY_HISTOGRAM_MAX_EXPONENT = 36;
+    inline constexpr std::size_t LATENCY_HISTOGRAM_SUB_BUCKETS =
+        std::size_t{1} << LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    inline constexpr std::size_t LATENCY_HISTOGRAM_BUCKETS =
+        2 * LATENCY_HISTOGRAM_SUB_BUCKETS +
+        (LATENCY_HISTOGRAM_MAX_EXPONENT - LATENCY_HISTOGRAM_SUB_BUCKET_BITS - 1) *
+            LATENCY_HISTOGRAM_SUB_BUCKETS;
+
+    [[nodiscard]]
+    constexpr std::size_t latencyHistogramBucket(std::uint64_t value_ns) noexcept
+    {
+        if (value_ns < 2 * LATENCY_HISTOGRAM_SUB_BUCKETS)
+            return static_cast<std::size_t>(value_ns);
+
+        const auto exponent = static_cast<unsigned>(std::bit_width(value_ns) - 1);
+        if (exponent >= LATENCY_HISTOGRAM_MAX_EXPONENT)
+            return LATENCY_HISTOGRAM_BUCKETS - 1;
+
+        const unsigned shift = exponent - LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+        const auto sub_bucket =
+            static_cast<std::size_t>(value_ns >> shift) - LATENCY_HISTOGRAM_SUB_BUCKETS;
+
+        return 2 * LATENCY_HISTOGRAM_SUB_BUCKETS +
+               (exponent - LATENCY_HISTOGRAM_SUB_BUCKET_BITS - 1) * LATENCY_HISTOGRAM_SUB_BUCKETS +
+               sub_bucket;
+    }
+
+    // Largest value that lands in `bucket`.
+    [[nodiscard]]
+    constexpr std::uint64_t latencyHistogramBucketUpperBound(std::size_t bucket) noexcept
+    {
+        if (bucket < 2 * LATENCY_HISTOGRAM_SUB_BUCKETS)
+            return bucket;
+
+        const std::size_t offset = bucket - 2 * LATENCY_HISTOGRAM_SUB_BUCKETS;
+        const auto exponent = static_cast<unsigned>(offset / LATENCY_HISTOGRAM_SUB_BUCKETS) +
+                              LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 1;
+        const std::uint64_t sub_bucket =
+            offset % LATENCY_HISTOGRAM_SUB_BUCKETS + LATENCY_HISTOGRAM_SUB_BUCKETS;
+
+        return ((sub_bucket + 1) << (exponent - LATENCY_HISTOGRAM_SUB_BUCKET_BITS)) - 1;
+    }
+
+    struct LatencyPercentiles
+    {
+        std::uint64_t count{0};
+        std::uint64_t p50_ns{0};
+        std::uint64_t p90_ns{0};
+        std::uint64_t p99_ns{0};
+        std::uint64_t p999_ns{0};
+        std::uint64_t max_ns{0};
+    };
+
+    // Plain, mergeable copy of one or more LatencyHistograms, used on the snapshot side.
+    class LatencyDistribution
+    {
+    public:
+        void record(std::uint64_t value_ns) noexcept
+        {
+            ++counts_[latencyHistogramBucket(value_ns)];
+            ++count_;
+            max_ns_ = std::max(max_ns_, value_ns);
+        }
+
+        void merge(const LatencyDistribution &other) noexcept
+        {
+            for (std::size_t bucket = 0; bucket < LATENCY_HISTOGRAM_BUCKETS; ++bucket)
+                counts_[bucket] += other.counts_[bucket];
+
+            count_ += other.count_;
+            max_ns_ = std::max(max_ns_, other.max_ns_);
+        }
+
+        // Removes an earlier copy of the same cumulative source, leaving only what was recorded
+        // since. The exact max is lost; it becomes the top of the highest non-empty bucket.
+        void subtract(const LatencyDistribution &earlier) noexcept
+        {
+            const std::uint64_t cumulative_max = max_ns_;
+            count_ = 0;
+            max_ns_ = 0;
+
+            for (std::size_t bucket = 0; bucket < LATENCY_HISTOGRAM_BUCKETS; ++bucket)
+            {
+                const std::uint64_t before = earlier.counts_[bucket];
+                counts_[bucket] = counts_[bucket] > before ? counts_[bucket] - before : 0;
+                count_ += counts_[bucket];
+
+                if (counts_[bucket] != 0)
+                    max_ns_ = std::min(latencyHistogramBucketUpperBound(bucket), cumulative_max);
+            }
+        }
+
+        [[nodiscard]]
+        std::uint64_t count() const noexcept
+        {
+            return count_;
+        }
+
+        [[nodiscard]]
+        std::uint64_t max() const noexcept
+        {
+            return max_ns_;
+        }
+
+        // Smallest bucket bound that at least `percentile` percent of samples fall at or below,
+        // capped at the recorded max. 0 when empty.
+        [[nodiscard]]
+        std::uint64_t valueAtPercentile(double percentile) const noexcept
+        {
+            if (count_ == 0)
+                return 0;
+
+            const double fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+            const auto rank = std::max<std::uint64_t>(
+                1, static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(count_))));
+
+            std::uint64_t seen = 0;
+            for (std::size_t bucket = 0; bucket < LATENCY_HISTOGRAM_BUCKETS; ++bucket)
+            {
+                seen += counts_[bucket];
+                if (seen >= rank)
+                {
+                    return bucket == LATENCY_HISTOGRAM_BUCKETS - 1
+                               ? max_ns_
+                               : std::min(latencyHistogramBucketUpperBound(bucket), max_ns_);
+                }
+            }
+
+            return max_ns_;
+        }
+
+        [[nodiscard]]
+        LatencyPercentiles percentiles() const noexcept
+        {
+            return LatencyPercentiles{.count = count_,
+                                      .p50_ns = valueAtPercentile(50.0),
+                                      .p90_ns = valueAtPercentile(90.0),
+                                      .p99_ns = valueAtPercentile(99.0),
+                                      .p999_ns = valueAtPercentile(99.9),
+                                      .max_ns = max_ns_};
+        }
+
+    private:
+        friend class LatencyHistogram;
+
+        std::array<std::uint64_t, LATENCY_HISTOGRAM_BUCKETS> counts_{};
+        std::uint64_t count_{0};
+        std::uint64_t max_ns_{0};
+    };
+
+    // Fixed-memory recording side. record() is lock-free and safe from any thread, but is meant
+    // to have one recording thread per histogram so bucket cache lines are not shared; readers
+    // merge every histogram into a LatencyDistribution at snapshot time.
+    class LatencyHistogram
+    {
+    public:
+        void record(std::uint64_t value_ns) noexcept
+        {
+            counts_[latencyHistogramBucket(value_ns)].fetch_add(1, std::memory_order_relaxed);
+
+            auto current_max = max_ns_.load(std::memory_order_relaxed);
+            while (value_ns > current_max &&
+                   !max_ns_.compare_exchange_weak(current_max, value_ns,
+                                                  std::memory_order_relaxed))
+            {
+            }
+        }
+
+        // Adds this histogram's samples so far to `out`. Concurrent records may or may not be
+        // included.
+        void mergeInto(LatencyDistribution &out) const noexcept
+        {
+            for (std::size_t bucket = 0; bucket < LATENCY_HISTOGRAM_BUCKETS; ++bucket)
+            {
+                const std::uint64_t count = counts_[bucket].load(std::memory_order_relaxed);
+                out.counts_[bucket] += count;
+                out.count_ += count;
+            }
+
+            out.max_ns_ = std::max(out.max_ns_, max_ns_.load(std::memory_order_relaxed));
+        }
+
+    private:
+        std::array<std::atomic_uint64_t, LATENCY_HISTOGRAM_BUCKETS> counts_{};
+        std::atomic_uint64_t max_ns_{0};
+    };
+} // namespace edgenetswitch
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "edgenetswitch/core/ShardedCounters.hpp"
 #include "edgenetswitch/packet/Packet.hpp"
 #include "edgenetswitch/transport/PortBackend.hpp"
 #include "edgenetswitch/transport/TransmitResult.hpp"
@@ -23,12 +24,26 @@ namespace edgenetswitch::transport
     {
     public:
         void registerBackend(std::uint32_t port_id, std::unique_ptr<PortBackend> backend);
+        // Backends must be registered before workers start; transmit() is then safe to call
+        // concurrently from every worker.
         TransmitResult transmit(std::uint32_t port_id, const Packet &packet);
-        const TransportCounters &counters() const noexcept;
+        // Safe to call from any thread while workers transmit.
+        TransportCounters counters() const noexcept;
         void resetCounters();
 
     private:
+        enum Counter : std::size_t
+        {
+            TxPackets,
+            TxBytes,
+            TxFailed,
+            BackendUnavailable,
+            PortDown,
+            InvalidPacket,
+            CounterCount
+        };
+
         std::unordered_map<std::uint32_t, std::unique_ptr<PortBackend>> backends_;
-        TransportCounters counters_;
+        ShardedCounters<CounterCount> counters_;
     };
 }; // namespace edgenetswitch::transport
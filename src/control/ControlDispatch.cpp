@@ -8,6 +8,9 @@
 #include "JsonResponse.hpp"
 #include "edgenetswitch/control/ControlContext.hpp"
 #include "edgenetswitch/core/Config.hpp"
+#include "edgenetswitch/core/CycleClock.hpp"
+#include "edgenetswitch/core/Logger.hpp"
+#include "edgenetswitch/packet/PacketStats.hpp"
 #include "edgenetswitch/runtime/RuntimeStatus.hpp"
 #include "edgenetswitch/system/fd/FdState.hpp"
 #include "edgenetswitch/system/fd/FdType.hpp"
@@ -207,13 +210,75 @@ namespace edgenetswitch::control
             return "validation_error";
         case PacketDropReason::QueueOverflow:
             return "queue_overflow";
+        case PacketDropReason::SimulatedLoss:
+            return "simulated_loss";
         case PacketDropReason::RateLimited:
             return "rate_limited";
+        case PacketDropReason::ProcessingError:
+            return "processing_error";
+        case PacketDropReason::InternalError:
+            return "internal_error";
+        case PacketDropReason::BufferExhausted:
+            return "buffer_exhausted";
         default:
             return "unknown";
         }
     }
 
+    static std::string dropSourceToString(PacketDropSource source)
+    {
+        switch (source)
+        {
+        case PacketDropSource::Ingress:
+            return "ingress";
+        case PacketDropSource::Processor:
+            return "processor";
+        case PacketDropSource::FailureInjector:
+            return "failure_injector";
+        }
+
+        return "unknown";
+    }
+
+    // Reasons with at least one drop, keyed by name.
+    static nlohmann::json dropCountsJson(const PacketDropCounts &counts)
+    {
+        nlohmann::json j = nlohmann::json::object();
+
+        for (std::size_t reason = 0; reason < PACKET_DROP_REASON_COUNT; ++reason)
+        {
+            if (counts[reason] != 0)
+                j[dropReasonToString(static_cast<PacketDropReason>(reason))] = counts[reason];
+        }
+
+        return j;
+    }
+
+    static std::string udpBatchBucketLabel(std::size_t bucket)
+    {
+        const std::uint64_t lower = std::uint64_t{1} << bucket;
+
+        if (bucket + 1 == UDP_BATCH_HISTOGRAM_BUCKETS)
+            return std::to_string(lower) + "+";
+
+        if (lower == 1)
+            return "1";
+
+        return std::to_string(lower) + "-" + std::to_string((lower << 1) - 1);
+    }
+
+    static nlohmann::json latencyPercentilesJson(const LatencyPercentiles &latency)
+    {
+        nlohmann::json j;
+        j["count"] = latency.count;
+        j["p50_ns"] = latency.p50_ns;
+        j["p90_ns"] = latency.p90_ns;
+        j["p99_ns"] = latency.p99_ns;
+        j["p999_ns"] = latency.p999_ns;
+        j["max_ns"] = latency.max_ns;
+        return j;
+    }
+
     static ControlResponse handlePacketStats(const ControlContext &ctx, const std::string &arg)
     {
         if (!arg.empty() && arg != "json")
@@ -236,25 +301,84 @@ namespace edgenetswitch::control
             j["processed_packets"] = snap->packet.processed_packets;
             j["processing_gap"] = snap->packet.processing_gap;
 
-            nlohmann::json drops_json = nlohmann::json::object();
+            j["drops"] = dropCountsJson(snap->packet.drops_by_reason);
 
-            for (const auto &[reason, count] : snap->packet.drops_by_reason)
+            nlohmann::json drops_by_source = nlohmann::json::object();
+            for (std::size_t source = 0; source < PACKET_DROP_SOURCE_COUNT; ++source)
             {
-                drops_json[dropReasonToString(reason)] = count;
+                drops_by_source[dropSourceToString(static_cast<PacketDropSource>(source))] =
+                    dropCountsJson(snap->packet.drops_by_source[source]);
             }
 
-            j["drops"] = drops_json;
+            j["drops_by_source"] = drops_by_source;
             j["rx_packets_per_sec"] = snap->packet.rx_packets_per_sec;
             j["rx_bytes_per_sec"] = snap->packet.rx_bytes_per_sec;
             j["rx_packets_per_sec_raw"] = snap->packet.rx_packets_per_sec_raw;
             j["rx_bytes_per_sec_raw"] = snap->packet.rx_bytes_per_sec_raw;
             j["terminal_events"] = snap->packet.terminal_events;
             j["duplicate_events"] = snap->packet.duplicate_events;
+            j["stale_lifecycle_events"] = snap->packet.stale_lifecycle_events;
             j["pending_terminal_events"] = snap->packet.pending_terminal_events;
             j["average_processing_latency_ns"] = snap->packet.average_processing_latency_ns;
             j["max_processing_latency_ns"] = snap->packet.max_processing_latency_ns;
             j["latency_samples"] = snap->packet.latency_samples;
+            j["processing_latency"] = latencyPercentilesJson(snap->packet.processing_latency);
+
+            // Reset-on-read: each json read reports what was recorded since the previous one.
+            const LatencyWindow window =
+                ctx.packet_stats ? ctx.packet_stats->takeProcessingLatencyWindow(nowMs())
+                                 : LatencyWindow{};
+            j["processing_latency_window"] = latencyPercentilesJson(window.latency);
+            j["processing_latency_window"]["window_ms"] = window.window_ms;
             j["udp_drain_completions"] = snap->packet.udp_drain_completions;
+            j["udp_batches"] = snap->packet.udp_batches;
+            j["buffer_pool_capacity"] = snap->packet.buffer_pool_capacity;
+            j["buffer_pool_in_use"] = snap->packet.buffer_pool_in_use;
+
+            nlohmann::json batch_json = nlohmann::json::object();
+
+            for (std::size_t bucket = 0; bucket < UDP_BATCH_HISTOGRAM_BUCKETS; ++bucket)
+            {
+                batch_json[udpBatchBucketLabel(bucket)] = snap->packet.udp_batch_histogram[bucket];
+            }
+
+            j["udp_batch_histogram"] = batch_json;
+
+            nlohmann::json receivers_json = nlohmann::json::array();
+
+            for (std::uint32_t id = 0; id < snap->packet.udp_receiver_count; ++id)
+            {
+                const auto &receiver = snap->packet.udp_receivers[id];
+
+                nlohmann::json receiver_json;
+                receiver_json["receiver"] = id;
+                receiver_json["ingress_packets"] = receiver.ingress_packets;
+                receiver_json["drain_completions"] = receiver.drain_completions;
+                receiver_json["batches"] = receiver.batches;
+
+                receivers_json.push_back(std::move(receiver_json));
+            }
+
+            j["udp_receivers"] = std::move(receivers_json);
+
+            nlohmann::json workers_json = nlohmann::json::array();
+
+            for (std::uint32_t id = 0; id < snap->packet.packet_worker_count; ++id)
+            {
+                const auto &worker = snap->packet.packet_workers[id];
+
+                nlohmann::json worker_json;
+                worker_json["worker"] = id;
+                worker_json["processed_packets"] = worker.processed_packets;
+                worker_json["drops"] = worker.drops;
+                worker_json["queue_overflow_drops"] = worker.queue_overflow_drops;
+                worker_json["average_latency_ns"] = worker.average_latency_ns;
+                worker_json["max_latency_ns"] = worker.max_latency_ns;
+
+                workers_json.push_back(std::move(worker_json));
+            }
+
+            j["packet_workers"] = std::move(workers_json);
 
             return makeJsonSuccess(j);
         }
@@ -269,30 +393,90 @@ namespace edgenetswitch::control
 
         std::uint64_t total_drops = 0;
 
-        for (const auto &[reason, count] : snap->packet.drops_by_reason)
+        for (std::size_t reason = 0; reason < PACKET_DROP_REASON_COUNT; ++reason)
         {
-            payload += "drops_" + dropReasonToString(reason) + "=" + std::to_string(count) + "\n";
+            const auto count = snap->packet.drops_by_reason[reason];
+            if (count == 0)
+                continue;
+
+            payload += "drops_" + dropReasonToString(static_cast<PacketDropReason>(reason)) + "=" +
+                       std::to_string(count) + "\n";
             total_drops += count;
         }
 
+        for (std::size_t source = 0; source < PACKET_DROP_SOURCE_COUNT; ++source)
+        {
+            std::uint64_t source_drops = 0;
+            for (const auto count : snap->packet.drops_by_source[source])
+                source_drops += count;
+
+            payload += "drops_source_" + dropSourceToString(static_cast<PacketDropSource>(source)) +
+                       "=" + std::to_string(source_drops) + "\n";
+        }
+
         payload += "drops_total=" + std::to_string(total_drops) + "\n";
 
         payload += "rx_packets_per_sec=" + std::to_string(snap->packet.rx_packets_per_sec) + "\n";
         payload += "rx_bytes_per_sec=" + std::to_string(snap->packet.rx_bytes_per_sec) + "\n";
         payload +=
             "rx_packets_per_sec_raw=" + std::to_string(snap->packet.rx_packets_per_sec_raw) + "\n";
-        payload += "rx_bytes_per_sec_raw=" + std::to_string(snap->packet.rx_bytes_per_sec_raw);
-        payload += "terminal_events=" + std::to_string(snap->packet.terminal_events);
-        payload += "duplicate_events=" + std::to_string(snap->packet.duplicate_events);
         payload +=
-            "pending_terminal_events=" + std::to_string(snap->packet.pending_terminal_events);
+            "rx_bytes_per_sec_raw=" + std::to_string(snap->packet.rx_bytes_per_sec_raw) + "\n";
+        payload += "terminal_events=" + std::to_string(snap->packet.terminal_events) + "\n";
+        payload += "duplicate_events=" + std::to_string(snap->packet.duplicate_events) + "\n";
+        payload += "stale_lifecycle_events=" +
+                   std::to_string(snap->packet.stale_lifecycle_events) + "\n";
+        payload += "pending_terminal_events=" +
+                   std::to_string(snap->packet.pending_terminal_events) + "\n";
         payload += "average_processing_latency_ns=" +
                    std::to_string(snap->packet.average_processing_latency_ns) + "\n";
         payload +=
             "max_processing_latency_ns=" + std::to_string(snap->packet.max_processing_latency_ns) +
             "\n";
+        payload += "processing_latency_p50_ns=" +
+                   std::to_string(snap->packet.processing_latency.p50_ns) + "\n";
+        payload += "processing_latency_p99_ns=" +
+                   std::to_string(snap->packet.processing_latency.p99_ns) + "\n";
+        payload += "processing_latency_p999_ns=" +
+                   std::to_string(snap->packet.processing_latency.p999_ns) + "\n";
         payload +=
             "udp_drain_completions=" + std::to_string(snap->packet.udp_drain_completions) + "\n";
+        payload += "udp_batches=" + std::to_string(snap->packet.udp_batches) + "\n";
+        payload +=
+            "buffer_pool_capacity=" + std::to_string(snap->packet.buffer_pool_capacity) + "\n";
+        payload += "buffer_pool_in_use=" + std::to_string(snap->packet.buffer_pool_in_use) + "\n";
+
+        for (std::size_t bucket = 0; bucket < UDP_BATCH_HISTOGRAM_BUCKETS; ++bucket)
+        {
+            payload += "udp_batch_" + udpBatchBucketLabel(bucket) + "=" +
+                       std::to_string(snap->packet.udp_batch_histogram[bucket]) + "\n";
+        }
+
+        for (std::uint32_t id = 0; id < snap->packet.udp_receiver_count; ++id)
+        {
+            const auto &receiver = snap->packet.udp_receivers[id];
+            const std::string prefix = "udp_receiver_" + std::to_string(id) + "_";
+
+            payload += prefix + "ingress_packets=" + std::to_string(receiver.ingress_packets) + "\n";
+            payload +=
+                prefix + "drain_completions=" + std::to_string(receiver.drain_completions) + "\n";
+            payload += prefix + "batches=" + std::to_string(receiver.batches) + "\n";
+        }
+
+        for (std::uint32_t id = 0; id < snap->packet.packet_worker_count; ++id)
+        {
+            const auto &worker = snap->packet.packet_workers[id];
+            const std::string prefix = "worker_" + std::to_string(id) + "_";
+
+            payload +=
+                prefix + "processed_packets=" + std::to_string(worker.processed_packets) + "\n";
+            payload += prefix + "drops=" + std::to_string(worker.drops) + "\n";
+            payload += prefix + "queue_overflow_drops=" +
+                       std::to_string(worker.queue_overflow_drops) + "\n";
+            payload +=
+                prefix + "average_latency_ns=" + std::to_string(worker.average_latency_ns) + "\n";
+            payload += prefix + "max_latency_ns=" + std::to_string(worker.max_latency_ns) + "\n";
+        }
 
         return ControlResponse{.success = true, .payload = std::move(payload)};
     }
@@ -317,6 +501,11 @@ namespace edgenetswitch::control
             j["daemon"]["tick_ms"] = cfg.daemon.tick_ms;
             j["udp"]["enabled"] = cfg.udp.enabled;
             j["udp"]["port"] = cfg.udp.port;
+            j["udp"]["batch_size"] = cfg.udp.batch_size;
+            j["udp"]["receivers"] = cfg.udp.receivers;
+            j["udp"]["buffer_pool_slabs"] = cfg.udp.buffer_pool_slabs;
+            j["processor"]["workers"] = cfg.processor.workers;
+            j["switching"]["mac_age_ms"] = cfg.switching.mac_age_ms;
             j["rate"]["alpha"] = cfg.rate.alpha;
             j["rate"]["window_ms"] = cfg.rate.window_ms;
 
@@ -329,6 +518,11 @@ namespace edgenetswitch::control
                        "daemon.tick_ms=" + std::to_string(cfg.daemon.tick_ms) + "\n" +
                        "udp.enabled=" + std::string(cfg.udp.enabled ? "true" : "false") + "\n" +
                        "udp.port=" + std::to_string(cfg.udp.port) + "\n" +
+                       "udp.batch_size=" + std::to_string(cfg.udp.batch_size) + "\n" +
+                       "udp.receivers=" + std::to_string(cfg.udp.receivers) + "\n" +
+                       "udp.buffer_pool_slabs=" + std::to_string(cfg.udp.buffer_pool_slabs) + "\n" +
+                       "processor.workers=" + std::to_string(cfg.processor.workers) + "\n" +
+                       "switching.mac_age_ms=" + std::to_string(cfg.switching.mac_age_ms) + "\n" +
                        "rate.alpha=" + std::to_string(cfg.rate.alpha) + "\n" +
                        "rate.window_ms=" + std::to_string(cfg.rate.window_ms)};
     }
@@ -353,14 +547,14 @@ namespace edgenetswitch::control
         packet.payload_size = static_cast<std::uint32_t>(packet.payload.size());
         packet.valid = true;
 
-        packet.source_mac = *source_mac;
-        packet.destination_mac = *destination_mac;
-        packet.ingress_port = ingress_port;
+        packet.setSourceMac(*source_mac);
+        packet.setDestinationMac(*destination_mac);
+        packet.setIngressPort(ingress_port);
 
         Message msg{};
         msg.type = MessageType::PacketRx;
         msg.timestamp_ms = packet.timestamp_ms;
-        msg.payload = packet;
+        msg.payload = std::move(packet);
 
         bus.publish(std::move(msg));
     }
@@ -434,11 +628,13 @@ namespace edgenetswitch::control
 
         if (arg == "mac-table")
         {
-            const auto entries = ctx.forwarding_engine->macTable().snapshot();
+            const auto &table = ctx.forwarding_engine->macTable();
+            const auto entries = table.snapshot();
 
             std::string payload;
 
             payload += "mac_table_size=" + std::to_string(entries.size()) + "\n";
+            payload += "mac_table_evictions=" + std::to_string(table.evictions()) + "\n";
 
             for (const auto &entry : entries)
             {
@@ -511,6 +707,11 @@ namespace edgenetswitch::control
                 fd["state"] = fdStateToString(record.state);
                 fd["type"] = fdTypeToString(record.fd_type);
 
+                if (!record.label.empty())
+                {
+                    fd["label"] = record.label;
+                }
+
                 fds.push_back(std::move(fd));
             }
 
@@ -528,7 +729,14 @@ namespace edgenetswitch::control
         {
             payload += "fd=" + std::to_string(record.fd) +
                        " state=" + fdStateToString(record.state) +
-                       " type=" + fdTypeToString(record.fd_type) + "\n";
+                       " type=" + fdTypeToString(record.fd_type);
+
+            if (!record.label.empty())
+            {
+                payload += " label=" + record.label;
+            }
+
+            payload += "\n";
         }
 
         return ControlResponse{.success = true, .payload = std::move(payload)};
@@ -546,7 +754,7 @@ namespace edgenetswitch::control
             return makeJsonError(error::InvalidRequest, "unsupported argument: " + arg);
         }
 
-        const auto &counters = ctx.transport_manager->counters();
+        const auto counters = ctx.transport_manager->counters();
 
         if (arg == "json")
         {
@@ -574,6 +782,102 @@ namespace edgenetswitch::control
         return ControlResponse{.success = true, .payload = std::move(payload)};
     }
 
+    static ControlResponse handlePipelineLatency(const ControlContext &ctx, const std::string &arg)
+    {
+        if (!arg.empty() && arg != "json")
+        {
+            return makeJsonError(error::InvalidRequest, "unsupported argument: " + arg);
+        }
+
+        auto snap = loadSnapshot(ctx);
+        if (!snap)
+        {
+            return makeJsonError(error::InternalError, "runtime snapshot not available");
+        }
+
+        const char *clock = CycleClock::usesTsc() ? "tsc" : "steady";
+
+        if (arg == "json")
+        {
+            nlohmann::json stages = nlohmann::json::array();
+
+            for (std::size_t stage = 0; stage < PIPELINE_STAGE_COUNT; ++stage)
+            {
+                nlohmann::json stage_json =
+                    latencyPercentilesJson(snap->packet.stage_latency[stage]);
+                stage_json["stage"] = toString(static_cast<PipelineStage>(stage));
+
+                stages.push_back(std::move(stage_json));
+            }
+
+            nlohmann::json j;
+            j["clock"] = clock;
+            j["stages"] = std::move(stages);
+
+            return makeJsonSuccess(j);
+        }
+
+        std::string payload;
+
+        payload += std::string("clock=") + clock + "\n";
+
+        for (std::size_t stage = 0; stage < PIPELINE_STAGE_COUNT; ++stage)
+        {
+            const auto &latency = snap->packet.stage_latency[stage];
+
+            payload += std::string("stage=") + toString(static_cast<PipelineStage>(stage)) +
+                       " count=" + std::to_string(latency.count) +
+                       " p50_ns=" + std::to_string(latency.p50_ns) +
+                       " p90_ns=" + std::to_string(latency.p90_ns) +
+                       " p99_ns=" + std::to_string(latency.p99_ns) +
+                       " p999_ns=" + std::to_string(latency.p999_ns) +
+                       " max_ns=" + std::to_string(latency.max_ns) + "\n";
+        }
+
+        return ControlResponse{.success = true, .payload = std::move(payload)};
+    }
+
+    static ControlResponse handleLogStats(const ControlContext &, const std::string &arg)
+    {
+        if (!arg.empty() && arg != "json")
+        {
+            return makeJsonError(error::InvalidRequest, "unsupported argument: " + arg);
+        }
+
+        const auto sites = Logger::rateLimitedSites();
+        const auto dropped = Logger::droppedCount();
+
+        if (arg == "json")
+        {
+            nlohmann::json entries = nlohmann::json::array();
+
+            for (const auto &site : sites)
+            {
+                entries.push_back({{"site", site.name},
+                                   {"emitted", site.emitted},
+                                   {"suppressed", site.suppressed}});
+            }
+
+            nlohmann::json j;
+            j["dropped_lines"] = dropped;
+            j["sites"] = std::move(entries);
+
+            return makeJsonSuccess(j);
+        }
+
+        std::string payload;
+
+        payload += "dropped_lines=" + std::to_string(dropped) + "\n";
+
+        for (const auto &site : sites)
+        {
+            payload += "site=" + site.name + " emitted=" + std::to_string(site.emitted) +
+                       " suppressed=" + std::to_string(site.suppressed) + "\n";
+        }
+
+        return ControlResponse{.success = true, .payload = std::move(payload)};
+    }
+
     static const CommandTable &commandTable()
     {
         // Static dispatch table:
@@ -621,7 +925,7 @@ namespace edgenetswitch::control
             {"show-config",
              {.name = "show-config",
               .description = "current runtime configuration",
-              .fields = {"log", "daemon", "udp", "rate"},
+              .fields = {"log", "daemon", "udp", "processor", "switching", "rate"},
               .handler = handleConfig}},
             {"send-packet",
              {.name = "send-packet",
@@ -636,7 +940,7 @@ namespace edgenetswitch::control
             {"fd-status",
              {.name = "fd-status",
               .description = "file descriptor runtime state",
-              .fields = {"fd", "state", "type"},
+              .fields = {"fd", "state", "type", "label"},
               .handler = handleFdStatus}},
             {"transport-stats",
              {.name = "transport-stats",
@@ -644,6 +948,17 @@ namespace edgenetswitch::control
               .fields = {"tx_packets", "tx_bytes", "tx_failed", "backend_unavailable", "port_down",
                          "invalid_packet"},
               .handler = handleTransportStats}},
+            {"log-stats",
+             {.name = "log-stats",
+              .description = "logger drops and rate-limited log sites",
+              .fields = {"dropped_lines", "site", "emitted", "suppressed"},
+              .handler = handleLogStats}},
+            {"pipeline-latency",
+             {.name = "pipeline-latency",
+              .description = "per-stage packet pipeline latency percentiles",
+              .fields = {"clock", "stage", "count", "p50_ns", "p90_ns", "p99_ns", "p999_ns",
+                         "max_ns"},
+              .handler = handlePipelineLatency}},
         };
         return table;
     }
@@ -20,9 +20,11 @@ namespace edgenetswitch::control
     ControlServer::ControlServer(FileDescriptor &listen_fd, daemon::SnapshotPublisher &publisher,
                                  const core::Config &config, MessagingBus &bus,
                                  SwitchForwardingEngine &forwarding_engine, FdRegistry &fd_registry,
-                                 edgenetswitch::transport::TransportManager &transport_manager)
+                                 edgenetswitch::transport::TransportManager &transport_manager,
+                                 PacketStats &packet_stats)
         : listen_fd_(listen_fd), publisher_(publisher), config_(config), bus_(bus),
-          forwarding_engine_(forwarding_engine), fd_registry_(fd_registry), transport_manager_(transport_manager)
+          forwarding_engine_(forwarding_engine), fd_registry_(fd_registry),
+          transport_manager_(transport_manager), packet_stats_(packet_stats)
 
     {
     }
@@ -46,7 +48,7 @@ namespace edgenetswitch::control
                     break;
                 }
 
-                Logger::error("Control socket accept failed");
+                EDGENETSWITCH_LOG_ERROR("Control socket accept failed");
                 break;
             }
 
@@ -78,12 +80,12 @@ namespace edgenetswitch::control
             // trim newline
             req.command.erase(req.command.find_last_not_of(" \n\r\t") + 1);
 
-            Logger::info("Control command received: " + req.command);
+            EDGENETSWITCH_LOG_INFO("Control command received: " + req.command);
 
             control::ControlContext ctx{
                 .publisher = &publisher_, .config = &config_, .bus = &bus_,
                 .forwarding_engine = &forwarding_engine_, .fd_registry = &fd_registry_,
-                .transport_manager = &transport_manager_};
+                .transport_manager = &transport_manager_, .packet_stats = &packet_stats_};
 
             const control::ControlResponse resp = control::dispatchControlRequest(req, ctx);
             writeControlResponse(client_fd, resp);
@@ -1,5 +1,7 @@
 #include "edgenetswitch/core/Config.hpp"
 #include "edgenetswitch/core/Logger.hpp"
+#include "edgenetswitch/network/UdpReceiverLimits.hpp"
+#include "edgenetswitch/packet/PacketWorkerLimits.hpp"
 
 #include <fstream>
 #include <stdexcept>
@@ -76,7 +78,7 @@ namespace edgenetswitch::core
             throw std::runtime_error(message);
         }
 
-        Logger::info("Loaded config: " + resolvedPath.string());
+        EDGENETSWITCH_LOG_INFO("Loaded config: " + resolvedPath.string());
 
         json j;
         try
@@ -103,6 +105,8 @@ namespace edgenetswitch::core
         json logJson = objectOrEmpty(j, "log");
         json daemonJson = objectOrEmpty(j, "daemon");
         json udpJson = objectOrEmpty(j, "udp");
+        json processorJson = objectOrEmpty(j, "processor");
+        json switchingJson = objectOrEmpty(j, "switching");
         json rateJson = objectOrEmpty(j, "rate");
 
         cfg.log.level = logJson.value("level", "info");
@@ -112,6 +116,13 @@ namespace edgenetswitch::core
 
         cfg.udp.enabled = udpJson.value("enabled", false);
         cfg.udp.port = udpJson.value("port", 9000);
+        cfg.udp.batch_size = udpJson.value("batch_size", 32u);
+        cfg.udp.receivers = udpJson.value("receivers", 1u);
+        cfg.udp.buffer_pool_slabs = udpJson.value("buffer_pool_slabs", 4096u);
+
+        cfg.processor.workers = processorJson.value("workers", 1u);
+
+        cfg.switching.mac_age_ms = switchingJson.value("mac_age_ms", std::uint64_t{300000});
 
         cfg.rate.alpha = rateJson.contains("alpha")
                              ? rateJson["alpha"].get<double>()
@@ -131,6 +142,29 @@ namespace edgenetswitch::core
             throw std::runtime_error("rate.window_ms must be > 0");
         }
 
+        if (cfg.udp.batch_size == 0 || cfg.udp.batch_size > MAX_UDP_BATCH_SIZE)
+        {
+            throw std::runtime_error("udp.batch_size must be in [1," +
+                                     std::to_string(MAX_UDP_BATCH_SIZE) + "]");
+        }
+
+        if (cfg.udp.receivers == 0 || cfg.udp.receivers > MAX_UDP_RECEIVERS)
+        {
+            throw std::runtime_error("udp.receivers must be in [1," +
+                                     std::to_string(MAX_UDP_RECEIVERS) + "]");
+        }
+
+        if (cfg.udp.buffer_pool_slabs == 0)
+        {
+            throw std::runtime_error("udp.buffer_pool_slabs must be > 0");
+        }
+
+        if (cfg.processor.workers == 0 || cfg.processor.workers > MAX_PACKET_WORKERS)
+        {
+            throw std::runtime_error("processor.workers must be in [1," +
+                                     std::to_string(MAX_PACKET_WORKERS) + "]");
+        }
+
         if (rateJson.contains("alpha") && !rateJson["alpha"].is_number())
         {
             throw std::runtime_error("rate.alpha must be a number");
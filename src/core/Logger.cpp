@@ -1,34 +1,143 @@
 #include "edgenetswitch/core/Logger.hpp"
+#include <algorithm>
+#include <cctype>
+#include <ctime>
 #include <iostream>
-#include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <utility>
 
 std::unique_ptr<Logger> Logger::instance_ = nullptr;
 
-static std::string timestamp()
+namespace
 {
-    using namespace std::chrono;
-    auto now = system_clock::now();
-    auto tt = system_clock::to_time_t(now);
-    std::tm tm = *std::localtime(&tt);
+    // How long the writer sleeps once every ring is empty.
+    constexpr std::chrono::milliseconds WriterIdle{10};
 
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%F %T");
-    return oss.str();
+    // Distinguishes Logger instances so a thread re-registers after shutdown()/init().
+    std::atomic<std::uint64_t> nextGeneration{1};
+
+    const char *levelName(LogLevel level)
+    {
+        switch (level)
+        {
+        case LogLevel::Debug:
+            return "DEBUG";
+        case LogLevel::Info:
+            return "INFO";
+        case LogLevel::Warning:
+            return "WARN";
+        case LogLevel::Error:
+            return "ERROR";
+        }
+
+        return "INFO";
+    }
+
+    // Registered LogRateLimiters. Function-local so call-site statics may register during
+    // static initialization.
+    std::mutex &limiterMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::vector<LogRateLimiter *> &limiters()
+    {
+        static std::vector<LogRateLimiter *> registered;
+        return registered;
+    }
+
+    std::uint64_t steadyNowNs() noexcept
+    {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+    }
+} // namespace
+
+LogRateLimiter::LogRateLimiter(std::string name, std::uint32_t per_second,
+                               std::uint32_t sample_every)
+    : name_(std::move(name)),
+      interval_ns_(1'000'000'000ull / std::max<std::uint32_t>(per_second, 1)),
+      tolerance_ns_(interval_ns_ * (std::max<std::uint32_t>(per_second, 1) - 1)),
+      sample_every_(std::max<std::uint32_t>(sample_every, 1))
+{
+    std::lock_guard<std::mutex> lock(limiterMutex());
+    limiters().push_back(this);
+}
+
+LogRateLimiter::~LogRateLimiter()
+{
+    std::lock_guard<std::mutex> lock(limiterMutex());
+    auto &registered = limiters();
+    registered.erase(std::remove(registered.begin(), registered.end(), this), registered.end());
+}
+
+bool LogRateLimiter::allow() noexcept
+{
+    const std::uint64_t call = calls_.fetch_add(1, std::memory_order_relaxed);
+
+    if (call % sample_every_ != 0 || !takeToken())
+    {
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    emitted_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool LogRateLimiter::takeToken() noexcept
+{
+    // Token bucket in its virtual-scheduling form: a token is available while the next
+    // token's due time is at most `tolerance_ns_` ahead of now; taking one pushes it back by
+    // one interval.
+    const std::uint64_t now = steadyNowNs();
+    std::uint64_t due = next_token_ns_.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        const std::uint64_t start = std::max(due, now);
+
+        if (start - now > tolerance_ns_)
+            return false;
+
+        if (next_token_ns_.compare_exchange_weak(due, start + interval_ns_,
+                                                 std::memory_order_relaxed))
+            return true;
+    }
 }
 
-Logger::Logger(LogLevel level, const std::string &filePath) : minLevel_(level), file_(filePath, std::ios::app) {}
+Logger::Logger(LogLevel level, const std::string &filePath)
+    : minLevel_(level), file_(filePath, std::ios::app),
+      generation_(nextGeneration.fetch_add(1, std::memory_order_relaxed))
+{
+    writer_ = std::thread([this] { writerLoop(); });
+}
+
+Logger::~Logger()
+{
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+
+    wake_.notify_one();
 
-Logger::~Logger() {}
+    if (writer_.joinable())
+        writer_.join();
+}
 
 void Logger::init(LogLevel level, const std::string &filePath)
 {
+    threshold_.store(Disabled, std::memory_order_relaxed);
     instance_ = std::unique_ptr<Logger>(new Logger(level, filePath));
+    threshold_.store(static_cast<int>(level), std::memory_order_relaxed);
 }
 
 void Logger::shutdown()
 {
+    threshold_.store(Disabled, std::memory_order_relaxed);
     instance_.reset();
 }
 
@@ -75,35 +184,189 @@ void Logger::error(const std::string &msg)
         instance_->log(LogLevel::Error, msg);
 }
 
+void Logger::reportSuppressed()
+{
+    if (!enabled(LogLevel::Warning))
+        return;
+
+    std::lock_guard<std::mutex> lock(limiterMutex());
+
+    for (auto *limiter : limiters())
+    {
+        const std::uint64_t suppressed = limiter->suppressed();
+        if (suppressed == limiter->reported_suppressed_)
+            continue;
+
+        warn("[LOGGER] suppressed " + std::to_string(suppressed - limiter->reported_suppressed_) +
+             " lines at " + limiter->name());
+        limiter->reported_suppressed_ = suppressed;
+    }
+}
+
+std::vector<LogSiteStats> Logger::rateLimitedSites()
+{
+    std::lock_guard<std::mutex> lock(limiterMutex());
+
+    std::vector<LogSiteStats> sites;
+    sites.reserve(limiters().size());
+
+    for (const auto *limiter : limiters())
+    {
+        sites.push_back({limiter->name(), limiter->emitted(), limiter->suppressed()});
+    }
+
+    return sites;
+}
+
+std::uint64_t Logger::droppedCount()
+{
+    return instance_ ? instance_->dropped_.load(std::memory_order_relaxed) : 0;
+}
+
 void Logger::log(LogLevel level, const std::string &msg)
 {
     if (level < minLevel_)
         return;
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    Record record{level, std::chrono::system_clock::now(), msg};
+
+    if (!ringForThisThread().ring.tryPush(std::move(record)))
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+Logger::ThreadRing &Logger::ringForThisThread()
+{
+    // Each thread is the only producer on its ring. The logger keeps the ring alive until
+    // the writer has drained it after the thread exits.
+    struct Slot
+    {
+        std::shared_ptr<ThreadRing> ring;
+        std::uint64_t generation{0};
+
+        ~Slot()
+        {
+            if (ring)
+                ring->retired.store(true, std::memory_order_release);
+        }
+    };
+
+    thread_local Slot slot;
+
+    if (!slot.ring || slot.generation != generation_)
+    {
+        auto ring = std::make_shared<ThreadRing>();
+
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            rings_.push_back(ring);
+        }
+
+        slot.ring = std::move(ring);
+        slot.generation = generation_;
+    }
+
+    return *slot.ring;
+}
+
+void Logger::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+
+    while (!stopping_)
+    {
+        lock.unlock();
+        const bool wrote = drainOnce();
+        lock.lock();
+
+        if (!wrote)
+            wake_.wait_for(lock, WriterIdle, [this] { return stopping_; });
+    }
+
+    lock.unlock();
+
+    // Final drain so shutdown() keeps everything logged before it.
+    while (drainOnce())
+    {
+    }
+}
+
+bool Logger::drainOnce()
+{
+    batch_.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+
+        Record record;
+        for (const auto &thread_ring : rings_)
+        {
+            for (std::size_t i = 0; i < RingCapacity && thread_ring->ring.tryPop(record); ++i)
+            {
+                batch_.push_back(std::move(record));
+            }
+        }
+
+        // Read `retired` before `empty()` so the owner's final push is already visible.
+        rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                    [](const std::shared_ptr<ThreadRing> &thread_ring)
+                                    {
+                                        return thread_ring->retired.load(
+                                                   std::memory_order_acquire) &&
+                                               thread_ring->ring.empty();
+                                    }),
+                     rings_.end());
+    }
 
-    std::string levelStr;
-    switch (level)
+    const std::uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != reported_dropped_)
     {
-    case LogLevel::Debug:
-        levelStr = "DEBUG";
-        break;
-    case LogLevel::Info:
-        levelStr = "INFO";
-        break;
-    case LogLevel::Warning:
-        levelStr = "WARN";
-        break;
-    case LogLevel::Error:
-        levelStr = "ERROR";
-        break;
+        batch_.push_back(Record{LogLevel::Warning, std::chrono::system_clock::now(),
+                                "[LOGGER] dropped " + std::to_string(dropped - reported_dropped_) +
+                                    " lines (ring full)"});
+        reported_dropped_ = dropped;
     }
 
-    std::string line = "[" + timestamp() + "][" + levelStr + "] " + msg;
+    if (batch_.empty())
+        return false;
+
+    // Rings are drained one after another; restore cross-thread order within the batch.
+    std::stable_sort(batch_.begin(), batch_.end(),
+                     [](const Record &lhs, const Record &rhs) { return lhs.time < rhs.time; });
+
+    out_.clear();
+    std::time_t last_second = -1;
+    char stamp[32] = {};
+
+    for (const auto &record : batch_)
+    {
+        const std::time_t second = std::chrono::system_clock::to_time_t(record.time);
+        if (second != last_second)
+        {
+            std::tm tm{};
+            localtime_r(&second, &tm);
+            std::strftime(stamp, sizeof(stamp), "%F %T", &tm);
+            last_second = second;
+        }
+
+        out_ += '[';
+        out_ += stamp;
+        out_ += "][";
+        out_ += levelName(record.level);
+        out_ += "] ";
+        out_ += record.msg;
+        out_ += '\n';
+    }
+
+    std::cout.write(out_.data(), static_cast<std::streamsize>(out_.size()));
+    std::cout.flush();
 
-    std::cout << line << std::endl;
     if (file_.is_open())
     {
-        file_ << line << std::endl;
+        file_.write(out_.data(), static_cast<std::streamsize>(out_.size()));
+        file_.flush();
     }
-}
\ No newline at end of file
+
+    return true;
+}
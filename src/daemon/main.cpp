@@ -8,6 +8,7 @@
 #include "edgenetswitch/network/IngressMode.hpp"
 #include "edgenetswitch/network/UdpReceiver.hpp"
 #include "edgenetswitch/packet/Packet.hpp"
+#include "edgenetswitch/packet/PacketBufferPool.hpp"
 #include "edgenetswitch/packet/PacketGenerator.hpp"
 #include "edgenetswitch/packet/PacketProcessor.hpp"
 #include "edgenetswitch/packet/PacketStats.hpp"
@@ -52,6 +53,7 @@
 #include <thread>
 #include <unistd.h>
 #include <utility>
+#include <vector>
 
 using namespace edgenetswitch;
 using namespace edgenetswitch::telemetry;
@@ -82,12 +84,22 @@ namespace
 
     constexpr const char *CONTROL_SOCKET_PATH = "/tmp/edgenetswitch.sock";
 
+    // One SO_REUSEPORT ingress receiver together with the epoll loop and thread that serve it.
+    struct UdpIngressShard
+    {
+        std::unique_ptr<UdpReceiver> receiver;
+        std::unique_ptr<UdpReadyHandler> handler;
+        std::unique_ptr<EpollManager> epoll;
+        std::unique_ptr<EpollEventLoop> loop;
+        std::thread thread;
+    };
+
     FileDescriptor createControlSocket(FdRegistry *fd_registry)
     {
         const int raw_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
         if (raw_fd < 0)
         {
-            Logger::error("Failed to create control socket");
+            EDGENETSWITCH_LOG_ERROR("Failed to create control socket");
             return {};
         }
 
@@ -102,7 +114,7 @@ namespace
 
         if (::bind(control_fd.get(), reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0)
         {
-            Logger::error("Failed to bind the control socket");
+            EDGENETSWITCH_LOG_ERROR("Failed to bind the control socket");
             control_fd.reset();
             return {};
         }
@@ -110,7 +122,7 @@ namespace
         // Allow the socket to accept incoming connections, with a queue size of up to 4
         if (::listen(control_fd.get(), 4) < 0)
         {
-            Logger::error("Failed to listen on control socket");
+            EDGENETSWITCH_LOG_ERROR("Failed to listen on control socket");
             control_fd.reset();
             return {};
         }
@@ -119,31 +131,31 @@ namespace
 
         if (flags < 0)
         {
-            Logger::error("Failed to get control socket flags");
+            EDGENETSWITCH_LOG_ERROR("Failed to get control socket flags");
             control_fd.reset();
             return {};
         }
 
         if (::fcntl(control_fd.get(), F_SETFL, flags | O_NONBLOCK) < 0)
         {
-            Logger::error("Failed to enable O_NONBLOCK on control socket");
+            EDGENETSWITCH_LOG_ERROR("Failed to enable O_NONBLOCK on control socket");
             control_fd.reset();
             return {};
         }
 
-        Logger::info("Control socket running in non-blocking mode");
+        EDGENETSWITCH_LOG_INFO("Control socket running in non-blocking mode");
 
-        Logger::info(std::string("Control socket listening at ") + CONTROL_SOCKET_PATH);
+        EDGENETSWITCH_LOG_INFO(std::string("Control socket listening at ") + CONTROL_SOCKET_PATH);
         return control_fd;
     }
 
     void destroyControlSocket(FileDescriptor &fd)
     {
-        Logger::debug("[CONTROL] Closing control socket fd=" + std::to_string(fd.get()));
+        EDGENETSWITCH_LOG_DEBUG("[CONTROL] Closing control socket fd=" + std::to_string(fd.get()));
         fd.reset();
-        Logger::debug("[CONTROL] Control socket close completed");
+        EDGENETSWITCH_LOG_DEBUG("[CONTROL] Control socket close completed");
         ::unlink(CONTROL_SOCKET_PATH);
-        Logger::info("Control socket closed");
+        EDGENETSWITCH_LOG_INFO("Control socket closed");
     }
 
     std::string cliTitleForCommand(const std::string &command)
@@ -166,7 +178,7 @@ namespace
         int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
         if (fd < 0)
         {
-            Logger::error("CLI: failed to create socket");
+            EDGENETSWITCH_LOG_ERROR("CLI: failed to create socket");
             return false;
         }
 
@@ -176,7 +188,7 @@ namespace
 
         if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0)
         {
-            Logger::error("CLI: connect() failed (is daemon running?)");
+            EDGENETSWITCH_LOG_ERROR("CLI: connect() failed (is daemon running?)");
             ::close(fd);
             return false;
         }
@@ -199,11 +211,13 @@ namespace
 
         if (accum.empty())
         {
-            Logger::warn("CLI: no response from daemon");
+            EDGENETSWITCH_LOG_WARN("CLI: no response from daemon");
             ::close(fd);
             return false;
         }
 
+        // The response is the CLI's output, not a diagnostic, so it bypasses the macros and
+        // their compile-time floor.
         Logger::info(cliTitleForCommand(command));
         Logger::info("--------------");
 
@@ -252,7 +266,7 @@ int main(int argc, char *argv[])
     core::Config cfg = core::ConfigLoader::loadFromFile("config/edgenetswitch.json");
 
     Logger::init(Logger::parseLevel(cfg.log.level), cfg.log.file);
-    Logger::info("EdgeNetSwitch daemon starting...");
+    EDGENETSWITCH_LOG_INFO("EdgeNetSwitch daemon starting...");
 
     FdRegistry fd_registry;
     {
@@ -292,31 +306,55 @@ int main(int argc, char *argv[])
             1, std::make_unique<transport::UdpPortBackend>(
                    1, transport::UdpEndpoint{"127.0.0.1", 9101}, &fd_registry));
 
-        PacketProcessor packetProcessor(bus, &forwardingEngine, &transportManager, failureInjector);
-        PacketStats packetStats(bus);
+        // Declared before everything that can hold an ingress packet so it is destroyed last.
+        PacketBufferPool bufferPool(cfg.udp.buffer_pool_slabs, cfg.udp.receivers);
+        PacketProcessor packetProcessor(bus, &forwardingEngine, &transportManager, failureInjector,
+                                        cfg.processor.workers);
+        PacketStats packetStats(bus, &bufferPool, cfg.udp.receivers);
         EpollManager epollManager(&fd_registry);
         EpollEventLoop epollLoop(epollManager, &fd_registry);
         TelemetryExportManager exportManager;
         FileDescriptor control_fd = createControlSocket(&fd_registry);
         std::thread epollThread;
-        std::unique_ptr<UdpReceiver> udpReceiver;
+        std::vector<UdpIngressShard> udpShards;
         RuntimeStatusBuilder statusBuilder(toSmootherConfig(cfg.rate));
-        std::unique_ptr<UdpReadyHandler> udpHandler;
         std::unique_ptr<control::ControlServer> controlServer;
         std::unique_ptr<ControlReadyHandler> controlHandler;
 
         if (cfg.udp.enabled)
         {
-            udpReceiver = std::make_unique<UdpReceiver>(bus, cfg.udp.port, &fd_registry,
-                                                        IngressMode::NonBlocking);
-            udpReceiver->initializeSocket();
+            const IngressMode ingress_mode =
+                cfg.udp.batch_size > 1 ? IngressMode::Batched : IngressMode::NonBlocking;
+
+            udpShards.reserve(cfg.udp.receivers);
+
+            for (std::uint32_t receiver_id = 0; receiver_id < cfg.udp.receivers; ++receiver_id)
+            {
+                UdpIngressShard shard;
+                shard.receiver = std::make_unique<UdpReceiver>(
+                    bus, cfg.udp.port, &fd_registry, ingress_mode, cfg.udp.batch_size, receiver_id,
+                    cfg.udp.receivers, &bufferPool);
+                shard.receiver->initializeSocket();
 
-            udpHandler = std::make_unique<UdpReadyHandler>(*udpReceiver);
+                if (shard.receiver->fd() < 0)
+                {
+                    EDGENETSWITCH_LOG_ERROR("UDP receiver " + std::to_string(receiver_id) +
+                                            " failed to initialize");
+                    continue;
+                }
+
+                shard.handler = std::make_unique<UdpReadyHandler>(*shard.receiver);
+                shard.epoll = std::make_unique<EpollManager>(&fd_registry);
+                shard.loop = std::make_unique<EpollEventLoop>(*shard.epoll, &fd_registry);
 
-            Logger::debug("UDP fd = " + std::to_string(udpReceiver->fd()));
+                EDGENETSWITCH_LOG_DEBUG("UDP receiver " + std::to_string(receiver_id) +
+                                        " fd = " + std::to_string(shard.receiver->fd()));
 
-            epollManager.add(udpReceiver->fd(), EPOLLIN);
-            epollLoop.registerHandler(udpReceiver->fd(), udpHandler.get());
+                shard.epoll->add(shard.receiver->fd(), EPOLLIN);
+                shard.loop->registerHandler(shard.receiver->fd(), shard.handler.get());
+
+                udpShards.push_back(std::move(shard));
+            }
         }
 
         exportManager.addExporter(std::make_unique<StdoutTelemetryExporter>());
@@ -336,7 +374,7 @@ int main(int argc, char *argv[])
         {
             controlServer = std::make_unique<control::ControlServer>(
                 control_fd, g_snapshotPublisher, cfg, bus, forwardingEngine, fd_registry,
-                transportManager);
+                transportManager, packetStats);
 
             controlHandler = std::make_unique<ControlReadyHandler>(*controlServer);
 
@@ -346,19 +384,33 @@ int main(int argc, char *argv[])
         }
         if (!control_fd.valid())
         {
-            Logger::error("Fatal: control socket initialization failed");
+            EDGENETSWITCH_LOG_ERROR("Fatal: control socket initialization failed");
             return EXIT_FAILURE;
         }
 
         epollThread = std::thread(
             [&epollLoop]()
             {
-                Logger::info("[EPOLL] Event loop thread started");
+                EDGENETSWITCH_LOG_INFO("[EPOLL] Event loop thread started");
                 epollLoop.run();
-                Logger::debug("[EPOLL] Event loop stopped");
-                Logger::debug("[EPOLL] Event loop thread exiting");
+                EDGENETSWITCH_LOG_DEBUG("[EPOLL] Event loop stopped");
+                EDGENETSWITCH_LOG_DEBUG("[EPOLL] Event loop thread exiting");
             });
 
+        for (auto &shard : udpShards)
+        {
+            shard.thread = std::thread(
+                [&shard]()
+                {
+                    const auto receiver_id = std::to_string(shard.receiver->receiverId());
+                    EDGENETSWITCH_LOG_INFO("[EPOLL][UDP " + receiver_id +
+                                           "] Event loop thread started");
+                    shard.loop->run();
+                    EDGENETSWITCH_LOG_DEBUG("[EPOLL][UDP " + receiver_id +
+                                            "] Event loop thread exiting");
+                });
+        }
+
 #ifdef EDGENETSWITCH_DEBUG_READER
         std::thread debugReaderThread(
             [&shutdownRequest]
@@ -368,7 +420,7 @@ int main(int argc, char *argv[])
                     auto snap = g_snapshotPublisher.load();
                     if (snap)
                     {
-                        Logger::debug(
+                        EDGENETSWITCH_LOG_DEBUG(
                             "debug_reader: version=" + std::to_string(snap->snapshot_version) +
                             " tick=" + std::to_string(snap->metrics.tick_count));
                     }
@@ -378,11 +430,11 @@ int main(int argc, char *argv[])
             });
 #endif
 
-        bus.subscribe(MessageType::SystemStart,
-                      [&](const Message &msg) { Logger::info("SystemStart received by daemon"); });
+        bus.subscribe(MessageType::SystemStart, [&](const Message &msg)
+                      { EDGENETSWITCH_LOG_INFO("SystemStart received by daemon"); });
 
         bus.subscribe(MessageType::SystemShutdown, [&](const Message &msg)
-                      { Logger::info("SystemShutdown received by daemon"); });
+                      { EDGENETSWITCH_LOG_INFO("SystemShutdown received by daemon"); });
 
         bus.subscribe(MessageType::Telemetry,
                       [&](const Message &msg)
@@ -412,11 +464,11 @@ int main(int argc, char *argv[])
 
                           if (!hs->is_alive)
                           {
-                              Logger::warn("HealthStatus: NOT ALIVE (timeout exceeded)");
+                              EDGENETSWITCH_LOG_WARN("HealthStatus: NOT ALIVE (timeout exceeded)");
                           }
                           else
                           {
-                              Logger::debug("HealthStatus: alive");
+                              EDGENETSWITCH_LOG_DEBUG("HealthStatus: alive");
                           }
                       });
 
@@ -424,12 +476,12 @@ int main(int argc, char *argv[])
                       [](const Message &msg)
                       {
                           const Packet &p = std::get<Packet>(msg.payload);
-                          Logger::info("Packet received: "
-                                       "id=" +
-                                       std::to_string(p.id) + " payload=" + p.payload +
-                                       " timestamp=" + formatTimestamp(p.timestamp_ms) +
-                                       " source_ip=" + p.source_ip +
-                                       " source_port=" + std::to_string(p.source_port));
+                          EDGENETSWITCH_LOG_DEBUG(
+                              "Packet received: id=" + std::to_string(p.id) +
+                              " payload=" + p.payload.str() +
+                              " timestamp=" + formatTimestamp(p.timestamp_ms) +
+                              " source_ip=" + formatIpv4(p.source_ipv4) +
+                              " source_port=" + std::to_string(p.source_port));
                       });
 
         bus.subscribe(MessageType::ForwardingDecisionMade,
@@ -448,17 +500,18 @@ int main(int argc, char *argv[])
                               action = "ForwardToPorts";
 
                           std::string ports;
-                          for (std::size_t i = 0; i < event->egress_ports.size(); ++i)
+                          for (const std::uint32_t port : event->egress_ports)
                           {
-                              if (i != 0)
+                              if (!ports.empty())
                                   ports += ",";
 
-                              ports += std::to_string(event->egress_ports[i]);
+                              ports += std::to_string(port);
                           }
 
-                          Logger::info("ForwardingDecisionMade: lifecycle_id=" +
-                                       std::to_string(event->lifecycle_id) + " action=" + action +
-                                       " egress_ports=[" + ports + "]");
+                          EDGENETSWITCH_LOG_DEBUG("ForwardingDecisionMade: lifecycle_id=" +
+                                                  std::to_string(event->lifecycle_id) +
+                                                  " action=" + action + " egress_ports=[" +
+                                                  ports + "]");
                       });
 
         bus.subscribe(MessageType::PacketProcessed,
@@ -466,7 +519,7 @@ int main(int argc, char *argv[])
                       {
                           const Packet &p = std::get<Packet>(msg.payload);
 
-                          Logger::info(
+                          EDGENETSWITCH_LOG_DEBUG(
                               "PacketProcessed: lifecycle_id=" + std::to_string(p.lifecycle_id) +
                               " packet_id=" + std::to_string(p.id));
                       });
@@ -491,6 +544,13 @@ int main(int argc, char *argv[])
 
             telemetry.onTick();
             healthMonitor.onTick();
+            Logger::reportSuppressed();
+
+            // Packet ticks are timestamp_ms, so the wall clock drives aging. The timing wheel
+            // makes this cost proportional to expirations, and ageMacTable() bounds how long it
+            // holds the forwarding lock, so it runs on every tick.
+            if (cfg.switching.mac_age_ms != 0)
+                packetProcessor.ageMacTable(nowMs(), cfg.switching.mac_age_ms);
 
             auto status =
                 statusBuilder.build(telemetry, healthMonitor, packetStats, runtimeState, nowMs());
@@ -506,38 +566,48 @@ int main(int argc, char *argv[])
         }
 #endif
 
-        Logger::info("[SHUTDOWN] Stopping epoll event loop");
+        EDGENETSWITCH_LOG_INFO("[SHUTDOWN] Stopping epoll event loop");
         epollLoop.stop();
-        Logger::info("[SHUTDOWN] Epoll event loop stop requested");
+        EDGENETSWITCH_LOG_INFO("[SHUTDOWN] Epoll event loop stop requested");
 
         if (epollThread.joinable())
         {
-            Logger::info("[SHUTDOWN] Waiting for epoll thread");
+            EDGENETSWITCH_LOG_INFO("[SHUTDOWN] Waiting for epoll thread");
             epollThread.join();
-            Logger::info("[SHUTDOWN] Epoll thread stopped");
+            EDGENETSWITCH_LOG_INFO("[SHUTDOWN] Epoll thread stopped");
         }
 
         destroyControlSocket(control_fd);
 
-        if (udpReceiver)
+        for (auto &shard : udpShards)
         {
-            Logger::info("[SHUTDOWN] Stopping UDP receiver");
-            udpReceiver->stop();
-            Logger::info("[SHUTDOWN] UDP receiver stopped");
+            const auto receiver_id = std::to_string(shard.receiver->receiverId());
+
+            EDGENETSWITCH_LOG_INFO("[SHUTDOWN] Stopping UDP receiver " + receiver_id);
+            shard.loop->stop();
+
+            if (shard.thread.joinable())
+            {
+                shard.thread.join();
+            }
+
+            shard.receiver->stop();
+            EDGENETSWITCH_LOG_INFO("[SHUTDOWN] UDP receiver " + receiver_id + " stopped");
         }
 
-        Logger::info("[SHUTDOWN] Stopping telemetry export manager");
+        EDGENETSWITCH_LOG_INFO("[SHUTDOWN] Stopping telemetry export manager");
         exportManager.stop();
-        Logger::info("[SHUTDOWN] Telemetry export manager stopped");
+        EDGENETSWITCH_LOG_INFO("[SHUTDOWN] Telemetry export manager stopped");
 
         runtimeState = RuntimeState::Stopping;
-        Logger::warn("Stop requested. Shutting down...");
-        Logger::info("[SHUTDOWN] Reason: " + std::string(toString(shutdownRequest.reason())));
+        EDGENETSWITCH_LOG_WARN("Stop requested. Shutting down...");
+        EDGENETSWITCH_LOG_INFO("[SHUTDOWN] Reason: " +
+                               std::string(toString(shutdownRequest.reason())));
         const auto status =
             statusBuilder.build(telemetry, healthMonitor, packetStats, runtimeState, nowMs());
-        Logger::info("RuntimeStatus: state=" + stateToString(status.state) +
-                     " uptime_ms=" + std::to_string(status.metrics.uptime_ms) +
-                     " tick_count=" + std::to_string(status.metrics.tick_count));
+        EDGENETSWITCH_LOG_INFO("RuntimeStatus: state=" + stateToString(status.state) +
+                               " uptime_ms=" + std::to_string(status.metrics.uptime_ms) +
+                               " tick_count=" + std::to_string(status.metrics.tick_count));
         bus.publish({MessageType::SystemShutdown, nowMs()});
     }
 
@@ -551,17 +621,17 @@ int main(int argc, char *argv[])
         {
             leak_detected = true;
 
-            Logger::error("[FD][LEAK] active descriptor detected during shutdown: fd=" +
-                          std::to_string(record.fd));
+            EDGENETSWITCH_LOG_ERROR("[FD][LEAK] active descriptor detected during shutdown: fd=" +
+                                    std::to_string(record.fd));
         }
     }
 
     if (!leak_detected)
     {
-        Logger::info("[FD] all descriptors released cleanly");
+        EDGENETSWITCH_LOG_INFO("[FD] all descriptors released cleanly");
     }
 
-    Logger::info("EdgeNetSwitch daemon stopped.");
+    EDGENETSWITCH_LOG_INFO("EdgeNetSwitch daemon stopped.");
     Logger::shutdown();
 
     return 0;
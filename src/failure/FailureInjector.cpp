@@ -28,6 +28,23 @@ namespace edgenetswitch::failure
 
     FailureInjector::FailureInjector(const FailureConfig &cfg) : config_(cfg) {}
 
+    FailureInjector::FailureInjector(const FailureInjector &other)
+        : config_(other.config_), seen_packets_(other.seen_packets_.load(std::memory_order_relaxed))
+    {
+    }
+
+    FailureInjector &FailureInjector::operator=(const FailureInjector &other)
+    {
+        if (this != &other)
+        {
+            config_ = other.config_;
+            seen_packets_.store(other.seen_packets_.load(std::memory_order_relaxed),
+                                std::memory_order_relaxed);
+        }
+
+        return *this;
+    }
+
     FailureResult FailureInjector::inject(const Packet &pkt, std::uint64_t)
     {
         if (!config_.enabled)
@@ -47,9 +64,9 @@ namespace edgenetswitch::failure
         if (config_.type == FailureType::None)
             return {FailureType::None, false};
 
-        ++seen_packets_;
+        const auto seen = seen_packets_.fetch_add(1, std::memory_order_relaxed) + 1;
 
-        if (seen_packets_ % config_.every_n_packets != 0)
+        if (seen % config_.every_n_packets != 0)
             return {FailureType::None, false};
 
         return makeFailureResult(config_.type, config_.delay_ms);
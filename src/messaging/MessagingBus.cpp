@@ -5,29 +5,95 @@
 namespace edgenetswitch
 {
 
+    template <typename Mutate> void MessagingBus::update(MessageType type, Mutate &&mutate)
+    {
+        const auto index = static_cast<std::size_t>(type);
+        if (index >= MESSAGE_TYPE_COUNT)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(subscribe_mutex_);
+
+        // Writers are serialized by the mutex, so a relaxed load sees the latest snapshot.
+        const Subscribers *current = subscribers_[index].load(std::memory_order_relaxed);
+
+        auto next = current ? std::make_unique<Subscribers>(*current)
+                            : std::make_unique<Subscribers>();
+        mutate(*next);
+
+        const Subscribers *published = next.get();
+        snapshots_.push_back(std::move(next));
+        subscribers_[index].store(published, std::memory_order_release);
+    }
+
     void MessagingBus::subscribe(MessageType type, Callback callback)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
-        subscribers_[type].push_back(std::move(callback));
+        update(type, [&](Subscribers &subscribers)
+               { subscribers.observers.push_back(std::move(callback)); });
+    }
+
+    void MessagingBus::subscribeSink(MessageType type, SinkCallback sink)
+    {
+        update(type, [&](Subscribers &subscribers)
+               { subscribers.sinks.push_back(std::move(sink)); });
+    }
+
+    const MessagingBus::Subscribers *MessagingBus::subscribersFor(MessageType type) const noexcept
+    {
+        const auto index = static_cast<std::size_t>(type);
+        if (index >= MESSAGE_TYPE_COUNT)
+        {
+            return nullptr;
+        }
+
+        return subscribers_[index].load(std::memory_order_acquire);
     }
 
     void MessagingBus::publish(const Message &message)
     {
-        std::vector<Callback> callbacks;
+        const Subscribers *subscribers = subscribersFor(message.type);
+        if (subscribers == nullptr)
+        {
+            return;
+        }
+
+        for (const auto &cb : subscribers->observers)
+        {
+            cb(message);
+        }
+
+        for (const auto &sink : subscribers->sinks)
+        {
+            sink(Message{message});
+        }
+    }
 
+    void MessagingBus::publish(Message &&message)
+    {
+        const Subscribers *subscribers = subscribersFor(message.type);
+        if (subscribers == nullptr)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            auto it = subscribers_.find(message.type);
-            if (it != subscribers_.end())
-            {
-                callbacks = it->second; // copy callbacks for safe iteration
-            }
+            return;
         }
 
-        for (const auto &cb : callbacks)
+        for (const auto &cb : subscribers->observers)
         {
             cb(message);
         }
+
+        const auto &sinks = subscribers->sinks;
+        if (sinks.empty())
+        {
+            return;
+        }
+
+        for (std::size_t i = 0; i + 1 < sinks.size(); ++i)
+        {
+            sinks[i](Message{message});
+        }
+
+        sinks.back()(std::move(message));
     }
 
 } // namespace edgenetswitch
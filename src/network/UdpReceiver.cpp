@@ -1,13 +1,17 @@
 #include "edgenetswitch/network/UdpReceiver.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <fcntl.h>
 #include <iostream>
+#include <string_view>
 
+#include "edgenetswitch/core/CycleClock.hpp"
 #include "edgenetswitch/core/Logger.hpp"
 #include "edgenetswitch/core/TimeUtils.hpp"
 #include "edgenetswitch/messaging/MessagingBus.hpp"
 #include "edgenetswitch/network/IngressMode.hpp"
+#include "edgenetswitch/network/UdpReceiverLimits.hpp"
 #include "edgenetswitch/packet/PacketParser.hpp"
 #include "edgenetswitch/packet/PacketValidator.hpp"
 #include "edgenetswitch/system/fd/FdRegistry.hpp"
@@ -20,10 +24,49 @@
 
 namespace edgenetswitch
 {
+    static_assert(PacketBufferPool::SlabSize >= UdpReceiver::MaxDatagramSize,
+                  "a pooled slab must hold a full datagram");
+
+    namespace
+    {
+        // Per-datagram drop warnings are rate-limited per call site so a malformed flood costs
+        // a counter increment; suppressed counts surface on the tick and via `log-stats`.
+        constexpr std::uint32_t DropLogsPerSecond = 10;
+        // Parse drops dump the raw datagram, so only every 8th is even considered.
+        constexpr std::uint32_t ParseDropLogSampleEvery = 8;
+    } // namespace
+
     UdpReceiver::UdpReceiver(MessagingBus &bus, int port, FdRegistry *fd_registry,
-                             IngressMode ingress_mode)
-        : bus_(bus), port_(port), fd_registry_(fd_registry), ingress_mode_((ingress_mode))
+                             IngressMode ingress_mode, std::size_t batch_size,
+                             std::uint32_t receiver_id, std::uint32_t receiver_count,
+                             PacketBufferPool *buffer_pool)
+        : bus_(bus), port_(port), receiver_id_(receiver_id),
+          receiver_count_(std::max<std::uint32_t>(receiver_count, 1)), fd_registry_(fd_registry),
+          buffer_pool_(buffer_pool),
+          lifecycle_gen_(receiver_id + 1, receiver_count_), ingress_mode_((ingress_mode)),
+          batch_size_(std::clamp<std::size_t>(batch_size, 1, MAX_UDP_BATCH_SIZE))
     {
+        if (ingress_mode_ != IngressMode::Batched)
+            return;
+
+        batch_buffers_.resize(batch_size_);
+        batch_addrs_.resize(batch_size_);
+        batch_iovecs_.resize(batch_size_);
+        batch_headers_.resize(batch_size_);
+
+        // Wire each mmsghdr to its own buffer and address slot once; recvmmsg() only
+        // rewrites msg_len and msg_namelen on every call.
+        for (std::size_t i = 0; i < batch_size_; ++i)
+        {
+            batch_iovecs_[i].iov_base = batch_buffers_[i].data();
+            batch_iovecs_[i].iov_len = batch_buffers_[i].size();
+
+            batch_headers_[i] = {};
+            batch_headers_[i].msg_hdr.msg_name = &batch_addrs_[i];
+            batch_headers_[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            batch_headers_[i].msg_hdr.msg_iov = &batch_iovecs_[i];
+            batch_headers_[i].msg_hdr.msg_iovlen = 1;
+        }
     }
 
     UdpReceiver::~UdpReceiver()
@@ -43,6 +86,25 @@ namespace edgenetswitch
 
         socket_fd_ = FileDescriptor(raw_fd, fd_registry_, FdType::UdpSocket);
 
+        if (fd_registry_)
+        {
+            fd_registry_->setLabel(socket_fd_.get(), "udp-rx-" + std::to_string(receiver_id_));
+        }
+
+        // Sharded ingress: every receiver binds the same port and the kernel spreads
+        // incoming flows across the sockets.
+        if (receiver_count_ > 1)
+        {
+            const int enable = 1;
+            if (::setsockopt(socket_fd_.get(), SOL_SOCKET, SO_REUSEPORT, &enable,
+                             sizeof(enable)) < 0)
+            {
+                EDGENETSWITCH_LOG_ERROR("Failed to enable SO_REUSEPORT");
+                socket_fd_.reset();
+                return;
+            }
+        }
+
         // Bind to port
         sockaddr_in addr{};
         addr.sin_family = AF_INET;
@@ -56,30 +118,38 @@ namespace edgenetswitch
             return;
         }
 
-        if (ingress_mode_ == IngressMode::NonBlocking)
+        if (ingress_mode_ == IngressMode::NonBlocking || ingress_mode_ == IngressMode::Batched)
         {
             // Read existing socket status flags before enabling O_NONBLOCK.
             const int flags = ::fcntl(socket_fd_.get(), F_GETFL, 0);
 
             if (flags < 0)
             {
-                Logger::error("Failed to get socket flags");
+                EDGENETSWITCH_LOG_ERROR("Failed to get socket flags");
                 socket_fd_.reset();
                 return;
             }
 
             if (::fcntl(socket_fd_.get(), F_SETFL, flags | O_NONBLOCK) < 0)
             {
-                Logger::error("Failed to enable O_NONBLOCK");
+                EDGENETSWITCH_LOG_ERROR("Failed to enable O_NONBLOCK");
                 socket_fd_.reset();
                 return;
             }
 
-            Logger::info("UDP receiver running in non-blocking mode");
+            if (ingress_mode_ == IngressMode::Batched)
+            {
+                EDGENETSWITCH_LOG_INFO("UDP receiver running in batched mode (batch_size=" +
+                                       std::to_string(batch_size_) + ")");
+            }
+            else
+            {
+                EDGENETSWITCH_LOG_INFO("UDP receiver running in non-blocking mode");
+            }
         }
         else
         {
-            Logger::info("UDP receiver running in blocking mode");
+            EDGENETSWITCH_LOG_INFO("UDP receiver running in blocking mode");
         }
     }
 
@@ -95,7 +165,7 @@ namespace edgenetswitch
         // Start worker thread
         worker_ = std::thread(&UdpReceiver::run, this);
 
-        std::cout << "[UDP] Listening on port " << port_ << "\n";
+        std::cout << "[UDP] Receiver " << receiver_id_ << " listening on port " << port_ << "\n";
     }
 
     void UdpReceiver::stop()
@@ -105,24 +175,24 @@ namespace edgenetswitch
             return;
         }
 
-        Logger::info("[UDP][SHUTDOWN] Stop requested");
+        EDGENETSWITCH_LOG_INFO("[UDP][SHUTDOWN] Stop requested");
 
         running_ = false;
 
         if (socket_fd_.valid())
         {
             socket_fd_.reset();
-            Logger::debug("[UDP][SHUTDOWN] Socket closed");
+            EDGENETSWITCH_LOG_DEBUG("[UDP][SHUTDOWN] Socket closed");
         }
 
         if (worker_.joinable())
         {
-            Logger::info("[UDP][SHUTDOWN] Waiting for worker thread");
+            EDGENETSWITCH_LOG_INFO("[UDP][SHUTDOWN] Waiting for worker thread");
             worker_.join();
-            Logger::info("[UDP][SHUTDOWN] Worker thread stopped");
+            EDGENETSWITCH_LOG_INFO("[UDP][SHUTDOWN] Worker thread stopped");
         }
 
-        Logger::info("[UDP][SHUTDOWN] UDP receiver stopped");
+        EDGENETSWITCH_LOG_INFO("[UDP][SHUTDOWN] UDP receiver stopped");
     }
 
     void UdpReceiver::run()
@@ -130,13 +200,50 @@ namespace edgenetswitch
 
         while (running_)
         {
-            handleReadable();
+            if (ingress_mode_ == IngressMode::Batched)
+            {
+                std::size_t received = 0;
+                handleReadableBatch(batch_size_, received);
+            }
+            else
+            {
+                handleReadable();
+            }
+        }
+    }
+
+    UdpReadResult UdpReceiver::handleReceiveError(int error)
+    {
+        if (error == EBADF)
+        {
+            running_ = false;
+            return UdpReadResult::Closed; // socket closed, exit thread cleanly
+        }
+
+        if (error == EINTR)
+            return UdpReadResult::NoData;
+
+        // Non-blocking sockets return EAGAIN/EWOULDBLOCK when no packet is available yet.
+        // This is an expected runtime condition, not a fatal socket error.
+        if (error == EAGAIN || error == EWOULDBLOCK)
+        {
+            Message msg{};
+            msg.type = MessageType::IngressIdlePoll;
+            msg.timestamp_ms = nowMs();
+            msg.payload = IngressIdlePoll{.timestamp_ms = msg.timestamp_ms,
+                                          .receiver_id = receiver_id_};
+            bus_.publish(std::move(msg));
+
+            return UdpReadResult::NoData;
         }
+
+        EDGENETSWITCH_LOG_ERROR("[UDP] receive failed: " + std::string(strerror(error)));
+        return UdpReadResult::Error;
     }
 
     UdpReadResult UdpReceiver::handleReadable()
     {
-        char buffer[1024];
+        char buffer[MaxDatagramSize];
         sockaddr_in client_addr{};
         socklen_t addr_len = sizeof(client_addr);
 
@@ -145,43 +252,68 @@ namespace edgenetswitch
 
         if (len < 0)
         {
-            if (errno == EBADF)
-            {
-                running_ = false;
-                return UdpReadResult::Closed; // socket closed, exit thread cleanly
-            }
+            return handleReceiveError(errno);
+        }
 
-            if (errno == EINTR)
-                return UdpReadResult::NoData;
+        handleDatagram(buffer, static_cast<std::size_t>(len), client_addr, addr_len, nowNs());
 
-            // Non-blocking sockets return EAGAIN/EWOULDBLOCK when no packet is available yet.
-            // This is an expected runtime condition, not a fatal socket error.
-            if (errno == EAGAIN || errno == EWOULDBLOCK)
-            {
-                Message msg{};
-                msg.type = MessageType::IngressIdlePoll;
-                msg.timestamp_ms = nowMs();
-                msg.payload = IngressIdlePoll{msg.timestamp_ms};
-                bus_.publish(std::move(msg));
+        return UdpReadResult::PacketProcessed;
+    }
 
-                return UdpReadResult::NoData;
-            }
+    UdpReadResult UdpReceiver::handleReadableBatch(std::size_t budget, std::size_t &received)
+    {
+        received = 0;
 
-            Logger::error("[UDP] recvfrom failed: " + std::string(strerror(errno)));
-            return UdpReadResult::Error;
+        const auto vlen = static_cast<unsigned int>(std::min(batch_size_, budget));
+        if (vlen == 0)
+            return UdpReadResult::NoData;
+
+        // The kernel shrinks msg_namelen to the actual address size; restore it for this call.
+        for (unsigned int i = 0; i < vlen; ++i)
+        {
+            batch_headers_[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        }
+
+        const int count = ::recvmmsg(socket_fd_.get(), batch_headers_.data(), vlen, 0, nullptr);
+
+        if (count < 0)
+        {
+            return handleReceiveError(errno);
         }
 
         const auto ingress_ts = nowNs();
 
-        std::string data(buffer, static_cast<size_t>(len));
-        Logger::info("[UDP] Packet received (" + std::to_string(len) + " bytes)");
+        Message batchMsg{};
+        batchMsg.type = MessageType::IngressBatchReceived;
+        batchMsg.timestamp_ms = nowMs();
+        batchMsg.payload = IngressBatchReceived{.datagram_count = static_cast<std::uint32_t>(count),
+                                                .timestamp_ms = batchMsg.timestamp_ms,
+                                                .receiver_id = receiver_id_};
+        bus_.publish(std::move(batchMsg));
+
+        for (int i = 0; i < count; ++i)
+        {
+            const auto &header = batch_headers_[i];
+
+            handleDatagram(batch_buffers_[i].data(), header.msg_len, batch_addrs_[i],
+                           header.msg_hdr.msg_namelen, ingress_ts);
+        }
+
+        received = static_cast<std::size_t>(count);
+        return UdpReadResult::PacketProcessed;
+    }
+
+    void UdpReceiver::handleDatagram(const char *buffer, std::size_t len,
+                                     const sockaddr_in &client_addr, socklen_t addr_len,
+                                     std::uint64_t ingress_ts)
+    {
+        const std::uint64_t received_ticks = CycleClock::now();
+        EDGENETSWITCH_LOG_DEBUG("[UDP] Packet received (" + std::to_string(len) + " bytes)");
 
         auto lifecycle_id = lifecycle_gen_.next();
-        auto packet = parsePacket(data);
-        packet.lifecycle_id = lifecycle_id;
-        packet.ingress_timestamp_ns = ingress_ts;
+        const auto parsed = parsePacketFields(std::string_view(buffer, len));
 
-        if (!packet.valid)
+        if (!parsed.ok())
         {
             const auto ts = nowMs();
 
@@ -189,23 +321,75 @@ namespace edgenetswitch
             dropMsg.type = MessageType::PacketDropped;
             dropMsg.timestamp_ms = ts;
             dropMsg.payload = PacketDropped{.reason = PacketDropReason::ParseError,
+                                            .source = PacketDropSource::Ingress,
                                             .timestamp_ms = ts,
                                             .packet_id = 0,
                                             .lifecycle_id = lifecycle_id};
 
             bus_.publish(std::move(dropMsg));
-            Logger::warn("[DROP][UDP][PARSE] len=" + std::to_string(len) + " data=[" + data + "]");
-            return UdpReadResult::PacketProcessed;
+            EDGENETSWITCH_LOG_WARN_LIMITED("udp.drop.parse", DropLogsPerSecond,
+                                           ParseDropLogSampleEvery,
+                                           "[DROP][UDP][PARSE] reason=" + toString(parsed.error) +
+                                               " len=" + std::to_string(len) + " data=[" +
+                                               std::string(buffer, len) + "]");
+            return;
         }
+
+        Packet packet;
+        packet.id = parsed.id;
+        packet.valid = true;
+        packet.payload_size = static_cast<std::uint32_t>(parsed.payload.size());
+        packet.setSourceMac(parsed.source_mac);
+        packet.setDestinationMac(parsed.destination_mac);
+        packet.setIngressPort(parsed.ingress_port);
+        packet.setWireFormat(parsed.format);
+
+        // An empty payload is rejected by validation below, so it never needs a slab.
+        if (buffer_pool_ && !parsed.payload.empty())
+        {
+            PacketBuffer slab = buffer_pool_->acquire(receiver_id_);
+
+            if (!slab.valid())
+            {
+                const auto ts = nowMs();
+
+                Message dropMsg{};
+                dropMsg.type = MessageType::PacketDropped;
+                dropMsg.timestamp_ms = ts;
+                dropMsg.payload = PacketDropped{.reason = PacketDropReason::BufferExhausted,
+                                                .source = PacketDropSource::Ingress,
+                                                .timestamp_ms = ts,
+                                                .packet_id = packet.id,
+                                                .lifecycle_id = lifecycle_id};
+
+                bus_.publish(std::move(dropMsg));
+                EDGENETSWITCH_LOG_WARN_LIMITED(
+                    "udp.drop.buffer_pool", DropLogsPerSecond, 1,
+                    "[DROP][UDP][POOL] buffer pool exhausted: receiver=" +
+                        std::to_string(receiver_id_));
+                return;
+            }
+
+            std::memcpy(slab.data(), buffer, len);
+            packet.payload =
+                PacketPayload(std::move(slab), parsed.payload_offset, parsed.payload.size());
+        }
+        else
+        {
+            packet.payload = std::string(parsed.payload);
+        }
+
+        packet.lifecycle_id = lifecycle_id;
+        packet.ingress_timestamp_ns = ingress_ts;
+        packet.ingress_receiver = receiver_id_;
         packet.timestamp_ms = nowMs();
         packet.wire_size = static_cast<std::uint32_t>(len);
 
-        // inet_ntoa() uses a static internal buffer (not thread-safe),
-        // but we immediately copy into std::string, so it's safe here.
-        packet.source_ip = inet_ntoa(client_addr.sin_addr);
-        // Convert port from network byte order (big-endian) to host byte order.
+        // Kept numeric; formatIpv4() renders it only where text is needed.
+        // Convert address and port from network byte order (big-endian) to host byte order.
         // Network protocols always use big-endian, but the host machine
         // (e.g. x86) is typically little-endian.
+        packet.source_ipv4 = ntohl(client_addr.sin_addr.s_addr);
         packet.source_port = ntohs(client_addr.sin_port);
 
         auto result = PacketValidator::validate(packet);
@@ -218,17 +402,23 @@ namespace edgenetswitch
             dropMsg.type = MessageType::PacketDropped;
             dropMsg.timestamp_ms = ts;
             dropMsg.payload = PacketDropped{.reason = PacketDropReason::ValidationError,
+                                            .source = PacketDropSource::Ingress,
                                             .timestamp_ms = ts,
                                             .packet_id = packet.id,
                                             .lifecycle_id = lifecycle_id};
 
             bus_.publish(std::move(dropMsg));
-            Logger::warn("[DROP][UDP][VALIDATION] Packet rejected: reason=" +
-                         toString(result.reason));
-            return UdpReadResult::PacketProcessed;
+            EDGENETSWITCH_LOG_WARN_LIMITED("udp.drop.validation", DropLogsPerSecond, 1,
+                                           "[DROP][UDP][VALIDATION] Packet rejected: reason=" +
+                                               toString(result.reason));
+            return;
         }
 
-        sendto(socket_fd_.get(), buffer, len, 0, (struct sockaddr *)&client_addr, addr_len);
+        packet.stages.start(received_ticks);
+        packet.stages.mark(PipelineStage::ParseValidate);
+
+        sendto(socket_fd_.get(), buffer, len, 0, (const struct sockaddr *)&client_addr, addr_len);
+        packet.stages.mark(PipelineStage::Echo);
 
         Message msg{};
         msg.type = MessageType::PacketRx;
@@ -236,8 +426,6 @@ namespace edgenetswitch
         msg.payload = std::move(packet);
 
         bus_.publish(std::move(msg));
-
-        return UdpReadResult::PacketProcessed;
     }
 
     int UdpReceiver::fd() const noexcept
@@ -245,23 +433,41 @@ namespace edgenetswitch
         return socket_fd_.get();
     }
 
+    std::uint32_t UdpReceiver::receiverId() const noexcept
+    {
+        return receiver_id_;
+    }
+
     void UdpReceiver::processReadableEvent()
     {
-        constexpr std::size_t MaxPacketsPerWakeup = 256;
+        constexpr std::size_t MaxPacketsPerWakeup = MAX_UDP_BATCH_SIZE;
 
         std::size_t packets_processed = 0;
 
         while (packets_processed < MaxPacketsPerWakeup)
         {
-            auto result = handleReadable();
+            UdpReadResult result;
 
-            if (result == UdpReadResult::PacketProcessed)
+            if (ingress_mode_ == IngressMode::Batched)
             {
-                ++packets_processed;
+                std::size_t received = 0;
+                result = handleReadableBatch(MaxPacketsPerWakeup - packets_processed, received);
+                packets_processed += received;
             }
+            else
+            {
+                result = handleReadable();
+
+                if (result == UdpReadResult::PacketProcessed)
+                {
+                    ++packets_processed;
+                }
+            }
+
             if (result == UdpReadResult::NoData)
             {
-                Logger::debug("[UDP] drained queue packets=" + std::to_string(packets_processed));
+                EDGENETSWITCH_LOG_DEBUG("[UDP] drained queue packets=" +
+                                        std::to_string(packets_processed));
                 break;
             }
 
@@ -277,7 +483,7 @@ namespace edgenetswitch
         }
         if (packets_processed == MaxPacketsPerWakeup)
         {
-            Logger::debug("[UDP] receive budget exhausted");
+            EDGENETSWITCH_LOG_DEBUG("[UDP] receive budget exhausted");
         }
     }
 } // namespace edgenetswitch
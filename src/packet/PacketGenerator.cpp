@@ -1,5 +1,7 @@
 #include "edgenetswitch/packet/PacketGenerator.hpp"
 
+#include <utility>
+
 namespace edgenetswitch
 {
     PacketGenerator::PacketGenerator(MessagingBus &bus) : bus_(bus) {};
@@ -14,9 +16,9 @@ namespace edgenetswitch
         Message msg;
         msg.type = MessageType::PacketRx;
         msg.timestamp_ms = now_ms;
-        msg.payload = packet;
+        msg.payload = std::move(packet);
 
-        bus_.publish(msg);
+        bus_.publish(std::move(msg));
     }
 
 } // namespace edgenetswitch
\ No newline at end of file
@@ -1,54 +1,268 @@
 #include "edgenetswitch/packet/PacketParser.hpp"
 
+#include <charconv>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
 namespace edgenetswitch
 {
-    Packet parsePacket(const std::string &data)
+    namespace
     {
-        Packet p{};
-        p.valid = false;
+        constexpr std::string_view IdKey = "id=";
+        constexpr std::string_view PayloadKey = "payload=";
 
-        if (data.empty())
-            return p;
+        // Value of `key` up to the next ';' (or the end of `data`), with its offset in `data`.
+        bool findField(std::string_view data, std::string_view key, std::string_view &value,
+                       std::size_t &offset) noexcept
+        {
+            const auto keyPos = data.find(key);
+            if (keyPos == std::string_view::npos)
+                return false;
 
-        auto idPos = data.find("id=");
-        if (idPos == std::string::npos)
-            return p;
+            offset = keyPos + key.size();
+            const auto end = data.find(';', offset);
+            value = data.substr(offset, end == std::string_view::npos ? std::string_view::npos
+                                                                      : end - offset);
+            return true;
+        }
 
-        auto end = data.find(';', idPos);
+        // Bounds-checked big-endian load of `size` bytes at `offset`.
+        bool loadBigEndian(std::string_view data, std::size_t offset, std::size_t size,
+                           std::uint64_t &value) noexcept
+        {
+            if (offset > data.size() || data.size() - offset < size)
+                return false;
 
-        std::string idStr;
-        if (end != std::string::npos)
-            idStr = data.substr(idPos + 3, end - (idPos + 3));
-        else
-            idStr = data.substr(idPos + 3);
+            value = 0;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                value = (value << 8) | static_cast<unsigned char>(data[offset + i]);
+            }
 
-        if (idStr.empty())
-            return p;
+            return true;
+        }
+
+        void storeBigEndian(std::string &out, std::uint64_t value, std::size_t size)
+        {
+            for (std::size_t i = size; i > 0; --i)
+            {
+                out.push_back(static_cast<char>((value >> ((i - 1) * 8)) & 0xFFu));
+            }
+        }
 
-        try
+        PacketParseResult parseBinary(std::string_view data) noexcept
         {
-            p.id = std::stoull(idStr);
+            PacketParseResult result{};
+            result.format = PacketWireFormat::Binary;
+
+            if (data.size() < BINARY_PACKET_HEADER_SIZE)
+            {
+                result.error = PacketParseError::TruncatedHeader;
+                return result;
+            }
+
+            std::uint64_t version = 0;
+            std::uint64_t flags = 0;
+            std::uint64_t source_mac = 0;
+            std::uint64_t destination_mac = 0;
+            std::uint64_t ingress_port = 0;
+            std::uint64_t payload_length = 0;
+
+            // The size check above covers every fixed field; the loads re-check regardless.
+            if (!loadBigEndian(data, 1, 1, version) || !loadBigEndian(data, 2, 2, flags) ||
+                !loadBigEndian(data, 4, 8, result.id) || !loadBigEndian(data, 12, 6, source_mac) ||
+                !loadBigEndian(data, 18, 6, destination_mac) ||
+                !loadBigEndian(data, 24, 4, ingress_port) ||
+                !loadBigEndian(data, 28, 2, payload_length))
+            {
+                result.error = PacketParseError::TruncatedHeader;
+                return result;
+            }
+
+            if (version != BINARY_PACKET_VERSION)
+            {
+                result.error = PacketParseError::UnsupportedVersion;
+                return result;
+            }
+
+            if (data.size() - BINARY_PACKET_HEADER_SIZE != payload_length)
+            {
+                result.error = PacketParseError::PayloadLengthMismatch;
+                return result;
+            }
+
+            result.payload_offset = BINARY_PACKET_HEADER_SIZE;
+            result.payload = data.substr(BINARY_PACKET_HEADER_SIZE);
+
+            if (flags & BINARY_FLAG_SOURCE_MAC)
+                result.source_mac = MacAddress::fromPacked(source_mac);
+
+            if (flags & BINARY_FLAG_DESTINATION_MAC)
+                result.destination_mac = MacAddress::fromPacked(destination_mac);
+
+            if (flags & BINARY_FLAG_INGRESS_PORT)
+                result.ingress_port = static_cast<std::uint32_t>(ingress_port);
+
+            return result;
         }
-        catch (...)
+
+        PacketParseResult parseText(std::string_view data) noexcept
         {
+            PacketParseResult result{};
+
+            std::string_view idStr;
+            std::size_t idOffset = 0;
+            if (!findField(data, IdKey, idStr, idOffset))
+            {
+                result.error = PacketParseError::MissingId;
+                return result;
+            }
+
+            if (idStr.empty())
+            {
+                result.error = PacketParseError::EmptyId;
+                return result;
+            }
+
+            const char *idEnd = idStr.data() + idStr.size();
+            const auto [ptr, ec] = std::from_chars(idStr.data(), idEnd, result.id);
+
+            if (ec == std::errc::result_out_of_range)
+            {
+                result.error = PacketParseError::IdOutOfRange;
+                return result;
+            }
+
+            if (ec != std::errc{} || ptr == idStr.data())
+            {
+                result.error = PacketParseError::InvalidId;
+                return result;
+            }
+
+            findField(data, PayloadKey, result.payload, result.payload_offset);
+
+            return result;
+        }
+
+        Packet toPacket(const PacketParseResult &result)
+        {
+            Packet p{};
+            p.valid = result.ok();
+
+            if (p.valid)
+            {
+                p.id = result.id;
+                p.payload_size = static_cast<std::uint32_t>(result.payload.size());
+                p.setSourceMac(result.source_mac);
+                p.setDestinationMac(result.destination_mac);
+                p.setIngressPort(result.ingress_port);
+                p.setWireFormat(result.format);
+            }
+
             return p;
         }
+    } // namespace
 
-        auto payloadPos = data.find("payload=");
-        if (payloadPos != std::string::npos)
+    std::string toString(PacketParseError error)
+    {
+        switch (error)
         {
-            auto payloadEnd = data.find(';', payloadPos);
+        case PacketParseError::None:
+            return "none";
+        case PacketParseError::EmptyInput:
+            return "empty_input";
+        case PacketParseError::MissingId:
+            return "missing_id";
+        case PacketParseError::EmptyId:
+            return "empty_id";
+        case PacketParseError::InvalidId:
+            return "invalid_id";
+        case PacketParseError::IdOutOfRange:
+            return "id_out_of_range";
+        case PacketParseError::TruncatedHeader:
+            return "truncated_header";
+        case PacketParseError::UnsupportedVersion:
+            return "unsupported_version";
+        case PacketParseError::PayloadLengthMismatch:
+            return "payload_length_mismatch";
+        default:
+            return "unknown";
+        }
+    }
 
-            if (payloadEnd != std::string::npos)
-                p.payload = data.substr(payloadPos + 8,
-                                        payloadEnd - (payloadPos + 8));
-            else
-                p.payload = data.substr(payloadPos + 8);
+    PacketParseResult parsePacketFields(std::string_view data) noexcept
+    {
+        if (data.empty())
+        {
+            PacketParseResult result{};
+            result.error = PacketParseError::EmptyInput;
+            return result;
         }
 
-        p.payload_size = static_cast<std::uint32_t>(p.payload.size());
-        p.valid = true;
+        if (static_cast<unsigned char>(data.front()) == BINARY_PACKET_MAGIC)
+            return parseBinary(data);
+
+        return parseText(data);
+    }
+
+    std::string encodeBinaryPacket(const Packet &packet)
+    {
+        const auto payload = packet.payload.view();
+
+        if (payload.size() > 0xFFFFu)
+        {
+            throw std::length_error("binary packet payload exceeds 65535 bytes");
+        }
+
+        const auto source_mac = packet.sourceMac();
+        const auto destination_mac = packet.destinationMac();
+        const auto ingress_port = packet.ingressPort();
+
+        std::uint16_t flags = 0;
+        if (source_mac)
+            flags |= BINARY_FLAG_SOURCE_MAC;
+        if (destination_mac)
+            flags |= BINARY_FLAG_DESTINATION_MAC;
+        if (ingress_port)
+            flags |= BINARY_FLAG_INGRESS_PORT;
+
+        std::string out;
+        out.reserve(BINARY_PACKET_HEADER_SIZE + payload.size());
+
+        storeBigEndian(out, BINARY_PACKET_MAGIC, 1);
+        storeBigEndian(out, BINARY_PACKET_VERSION, 1);
+        storeBigEndian(out, flags, 2);
+        storeBigEndian(out, packet.id, 8);
+        storeBigEndian(out, source_mac ? source_mac->packed() : 0, 6);
+        storeBigEndian(out, destination_mac ? destination_mac->packed() : 0, 6);
+        storeBigEndian(out, ingress_port.value_or(0), 4);
+        storeBigEndian(out, payload.size(), 2);
+        out.append(payload);
+
+        return out;
+    }
+
+    Packet parsePacket(std::string_view data)
+    {
+        const auto result = parsePacketFields(data);
+        Packet p = toPacket(result);
+
+        if (p.valid && !result.payload.empty())
+            p.payload = std::string(result.payload);
+
+        return p;
+    }
+
+    Packet parsePacket(PacketBuffer buffer, std::size_t length)
+    {
+        const auto result = parsePacketFields(std::string_view(buffer.data(), length));
+        Packet p = toPacket(result);
+
+        if (p.valid && !result.payload.empty())
+            p.payload = PacketPayload(std::move(buffer), result.payload_offset,
+                                      result.payload.size());
 
         return p;
     }
-} // namespace edgenetswitch
\ No newline at end of file
+} // namespace edgenetswitch
@@ -6,6 +6,8 @@
 #include "edgenetswitch/switching/SwitchForwardingEngine.hpp"
 #include "edgenetswitch/transport/TransmitResult.hpp"
 
+#include <stdexcept>
+#include <string>
 #include <utility>
 
 namespace edgenetswitch
@@ -36,50 +38,99 @@ namespace edgenetswitch
             switch (result.status)
             {
             case transport::TransmitStatus::Success:
-                Logger::info("Transport transmit: "
-                             "port=" +
-                             std::to_string(result.port_id) + " status=" + toString(result.status) +
-                             " bytes=" + std::to_string(result.bytes_transmitted));
+                EDGENETSWITCH_LOG_DEBUG("Transport transmit: "
+                                        "port=" +
+                                        std::to_string(result.port_id) +
+                                        " status=" + toString(result.status) +
+                                        " bytes=" + std::to_string(result.bytes_transmitted));
                 break;
             case transport::TransmitStatus::PortDown:
-                Logger::warn("Transport transmit skipped: "
-                             "port=" +
-                             std::to_string(result.port_id) + " status=" + toString(result.status));
+                EDGENETSWITCH_LOG_WARN("Transport transmit skipped: "
+                                       "port=" +
+                                       std::to_string(result.port_id) +
+                                       " status=" + toString(result.status));
                 break;
             case transport::TransmitStatus::BackendUnavailable:
-                Logger::warn("Transport backend unavailable: "
-                             "port=" +
-                             std::to_string(result.port_id) + " status=" + toString(result.status));
+                EDGENETSWITCH_LOG_WARN("Transport backend unavailable: "
+                                       "port=" +
+                                       std::to_string(result.port_id) +
+                                       " status=" + toString(result.status));
                 break;
             case transport::TransmitStatus::InvalidPacket:
-                Logger::warn("Transport transmit rejected: "
-                             "port=" +
-                             std::to_string(result.port_id) + " status=" + toString(result.status));
+                EDGENETSWITCH_LOG_WARN("Transport transmit rejected: "
+                                       "port=" +
+                                       std::to_string(result.port_id) +
+                                       " status=" + toString(result.status));
                 break;
             case transport::TransmitStatus::SendFailed:
-                Logger::error("Transport transmit failed: "
-                              "port=" +
-                              std::to_string(result.port_id) +
-                              " status=" + toString(result.status) +
-                              " errno=" + std::to_string(result.native_error));
+                EDGENETSWITCH_LOG_ERROR("Transport transmit failed: "
+                                        "port=" +
+                                        std::to_string(result.port_id) +
+                                        " status=" + toString(result.status) +
+                                        " errno=" + std::to_string(result.native_error));
                 break;
             default:
-                Logger::error("Unknown transport status");
+                EDGENETSWITCH_LOG_ERROR("Unknown transport status");
                 break;
             }
         }
+
+        std::uint64_t mixFlowKey(std::uint64_t hash, std::uint64_t value) noexcept
+        {
+            // FNV-1a over the 8 bytes of value; deterministic across runs and platforms.
+            for (int shift = 0; shift < 64; shift += 8)
+            {
+                hash ^= (value >> shift) & 0xFFu;
+                hash *= 0x100000001B3ull;
+            }
+
+            return hash;
+        }
     } // namespace
+
+    std::uint64_t packetFlowHash(const Packet &packet) noexcept
+    {
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+
+        const auto ingress_port = packet.ingressPort();
+        const auto source_mac = packet.sourceMac();
+
+        if (ingress_port && source_mac)
+        {
+            hash = mixFlowKey(hash, *ingress_port);
+            return mixFlowKey(hash, source_mac->packed());
+        }
+
+        hash = mixFlowKey(hash, packet.source_ipv4);
+        return mixFlowKey(hash, packet.source_port);
+    }
+
     PacketProcessor::PacketProcessor(MessagingBus &bus, SwitchForwardingEngine *forwarding_engine,
                                      transport::TransportManager *transport_manager,
-                                     failure::FailureInjector injector)
+                                     failure::FailureInjector injector,
+                                     std::uint32_t worker_count, RingProducerMode producer_mode)
         : bus_(bus), injector_(std::move(injector)), forwarding_engine_(forwarding_engine),
           transport_manager_(transport_manager)
     {
-        bus_.subscribe(
+        if (worker_count == 0 || worker_count > MAX_PACKET_WORKERS)
+        {
+            throw std::invalid_argument("PacketProcessor worker_count must be in [1," +
+                                        std::to_string(MAX_PACKET_WORKERS) + "]");
+        }
+
+        workers_.reserve(worker_count);
+        for (std::uint32_t id = 0; id < worker_count; ++id)
+        {
+            workers_.push_back(std::make_unique<Worker>(id, producer_mode));
+        }
+
+        // Registered as the PacketRx sink so the admitted packet is moved into the worker ring
+        // rather than copied, after every observer has seen it.
+        bus_.subscribeSink(
             MessageType::PacketRx,
-            [this](const Message &msg)
+            [this](Message &&msg)
             {
-                const Packet *packet = std::get_if<Packet>(&msg.payload);
+                Packet *packet = std::get_if<Packet>(&msg.payload);
 
                 if (!packet)
                     return;
@@ -98,85 +149,153 @@ namespace edgenetswitch
                         std::chrono::milliseconds(static_cast<int>(failure.delay_ms)));
                 }
 
-                bool shouldDrop = false;
-                {
-                    std::lock_guard<std::mutex> lock(queue_mutex_);
-                    if (queue_.size() >= MAX_QUEUE_SIZE)
-                    {
-                        shouldDrop = true;
-                    }
-                    else
-                    {
-                        queue_.push_back(*packet);
-                    }
-                }
+                Worker &worker = *workers_[workerFor(*packet)];
 
-                if (shouldDrop)
+                packet->processor_worker = worker.id;
+                packet->worker_enqueue_ns = nowNs();
+                packet->stages.mark(PipelineStage::BusPublish);
+
+                // tryPush() only moves from the packet when it succeeds.
+                if (!worker.queue.tryPush(std::move(*packet)))
                 {
                     Message dropMsg{};
                     dropMsg.type = MessageType::PacketDropped;
                     dropMsg.timestamp_ms = now_ms;
                     dropMsg.payload = PacketDropped{.reason = PacketDropReason::QueueOverflow,
+                                                    .source = PacketDropSource::Processor,
                                                     .timestamp_ms = dropMsg.timestamp_ms,
                                                     .packet_id = packet->id,
-                                                    .lifecycle_id = packet->lifecycle_id};
+                                                    .lifecycle_id = packet->lifecycle_id,
+                                                    .processor_worker = worker.id};
 
                     bus_.publish(std::move(dropMsg));
                 }
                 else
                 {
-                    cv_.notify_one();
+                    wakeWorker(worker);
                 }
             });
 
-        worker_ = std::thread([this]() { processLoop(); });
+        for (auto &entry : workers_)
+        {
+            entry->thread = std::thread([this, &worker = *entry]() { processLoop(worker); });
+        }
     }
 
     PacketProcessor::~PacketProcessor()
     {
-        running_.store(false, std::memory_order_relaxed);
-        cv_.notify_all();
-        if (worker_.joinable())
-            worker_.join();
+        running_.store(false, std::memory_order_seq_cst);
+
+        for (auto &worker : workers_)
+        {
+            worker->wake_epoch.fetch_add(1, std::memory_order_release);
+            worker->wake_epoch.notify_one();
+        }
+
+        for (auto &worker : workers_)
+        {
+            if (worker->thread.joinable())
+                worker->thread.join();
+        }
+    }
+
+    void PacketProcessor::ageMacTable(std::uint64_t now_tick, std::uint64_t max_age)
+    {
+        if (!forwarding_engine_)
+            return;
+
+        for (std::size_t aged = 0; aged < MAC_AGE_TICK_BUDGET;)
+        {
+            std::lock_guard<std::mutex> lock(forwarding_mutex_);
+            const auto removed = forwarding_engine_->ageMacTable(now_tick, max_age, MAC_AGE_BATCH);
+            aged += removed;
+
+            if (removed < MAC_AGE_BATCH)
+                break;
+        }
+    }
+
+    std::uint32_t PacketProcessor::workerCount() const noexcept
+    {
+        return static_cast<std::uint32_t>(workers_.size());
     }
 
-    void PacketProcessor::processLoop()
+    std::uint32_t PacketProcessor::workerFor(const Packet &packet) const noexcept
     {
-        while (true)
+        if (workers_.size() == 1)
+            return 0;
+
+        return static_cast<std::uint32_t>(packetFlowHash(packet) % workers_.size());
+    }
+
+    void PacketProcessor::wakeWorker(Worker &worker)
+    {
+        // Pairs with the fence in waitForPacket(): either the worker sees the packet we just
+        // published, or we see worker.parked and bump the epoch it is waiting on.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (worker.parked.load(std::memory_order_relaxed))
         {
-            Packet packet;
+            worker.wake_epoch.fetch_add(1, std::memory_order_release);
+            worker.wake_epoch.notify_one();
+        }
+    }
 
+    bool PacketProcessor::waitForPacket(Worker &worker, Packet &packet)
+    {
+        while (true)
+        {
+            for (int spin = 0; spin < SPIN_BEFORE_PARK; ++spin)
             {
-                std::unique_lock<std::mutex> lock(queue_mutex_);
+                if (worker.queue.tryPop(packet))
+                    return true;
 
-                cv_.wait(lock,
-                         [this]
-                         {
-                             // Continue waiting only while queue is empty AND system is running.
-                             return !queue_.empty() || !running_;
-                         });
+                if (!running_.load(std::memory_order_acquire))
+                    return worker.queue.tryPop(packet);
+            }
 
-                if (!running_ && queue_.empty())
-                    break;
+            const auto epoch = worker.wake_epoch.load(std::memory_order_acquire);
+            worker.parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
 
-                packet = std::move(queue_.front());
-                queue_.pop_front();
+            // Re-check after announcing the park so a packet pushed in between is not missed.
+            if (!worker.queue.empty() || !running_.load(std::memory_order_acquire))
+            {
+                worker.parked.store(false, std::memory_order_relaxed);
+                continue;
             }
-            processPacket(packet);
+
+            worker.wake_epoch.wait(epoch, std::memory_order_acquire);
+            worker.parked.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void PacketProcessor::processLoop(Worker &worker)
+    {
+        Packet packet;
+
+        // Drains whatever is still queued after shutdown is requested, then exits.
+        while (waitForPacket(worker, packet))
+        {
+            processPacket(std::move(packet));
         }
     }
 
     void PacketProcessor::processPacket(Packet processedPacket)
     {
+        processedPacket.stages.mark(PipelineStage::QueueWait);
+
         if (processedPacket.payload.size() > MAX_PAYLOAD_SIZE)
         {
             Message dropMsg{};
             dropMsg.type = MessageType::PacketDropped;
             dropMsg.timestamp_ms = processedPacket.timestamp_ms;
             dropMsg.payload = PacketDropped{.reason = PacketDropReason::ValidationError,
+                                            .source = PacketDropSource::Processor,
                                             .timestamp_ms = processedPacket.timestamp_ms,
                                             .packet_id = processedPacket.id,
-                                            .lifecycle_id = processedPacket.lifecycle_id};
+                                            .lifecycle_id = processedPacket.lifecycle_id,
+                                            .processor_worker = processedPacket.processor_worker};
 
             bus_.publish(std::move(dropMsg));
             return;
@@ -188,9 +307,11 @@ namespace edgenetswitch
             dropMsg.type = MessageType::PacketDropped;
             dropMsg.timestamp_ms = nowMs();
             dropMsg.payload = PacketDropped{.reason = PacketDropReason::ValidationError,
+                                            .source = PacketDropSource::Processor,
                                             .timestamp_ms = dropMsg.timestamp_ms,
                                             .packet_id = processedPacket.id,
-                                            .lifecycle_id = processedPacket.lifecycle_id};
+                                            .lifecycle_id = processedPacket.lifecycle_id,
+                                            .processor_worker = processedPacket.processor_worker};
 
             bus_.publish(std::move(dropMsg));
             return;
@@ -198,11 +319,18 @@ namespace edgenetswitch
 
         processedPacket.payload_size = static_cast<std::uint32_t>(processedPacket.payload.size());
 
-        if (forwarding_engine_ && processedPacket.ingress_port)
+        const auto ingress_port = processedPacket.ingressPort();
+
+        if (forwarding_engine_ && ingress_port)
         {
-            auto decision = forwarding_engine_->processPacket(
-                processedPacket, *processedPacket.ingress_port, processedPacket.timestamp_ms);
+            std::unique_lock<std::mutex> forwarding_lock(forwarding_mutex_);
 
+            auto decision = forwarding_engine_->processPacket(processedPacket, *ingress_port,
+                                                              processedPacket.timestamp_ms);
+            forwarding_lock.unlock();
+            processedPacket.stages.mark(PipelineStage::Switching);
+
+            // Transmits run outside the lock so workers overlap their sendto() calls.
             if (transport_manager_)
             {
                 if (!decision.egress_ports.empty())
@@ -215,8 +343,10 @@ namespace edgenetswitch
                 }
                 else
                 {
-                    Logger::debug("Transport dispatch skipped: no egress ports");
+                    EDGENETSWITCH_LOG_DEBUG("Transport dispatch skipped: no egress ports");
                 }
+
+                processedPacket.stages.mark(PipelineStage::Transport);
             }
 
             Message forwarding{};
@@ -234,9 +364,9 @@ namespace edgenetswitch
         Message processed{};
         processed.type = MessageType::PacketProcessed;
         processed.timestamp_ms = processedPacket.timestamp_ms;
-        processed.payload = processedPacket;
+        processed.payload = std::move(processedPacket);
 
-        bus_.publish(processed);
+        bus_.publish(std::move(processed));
     }
 
     void PacketProcessor::handleInjectedFailure(const Packet &pkt,
@@ -268,6 +398,7 @@ namespace edgenetswitch
         dropMsg.type = MessageType::PacketDropped;
         dropMsg.timestamp_ms = now_ms;
         dropMsg.payload = PacketDropped{.reason = reason,
+                                        .source = PacketDropSource::FailureInjector,
                                         .timestamp_ms = dropMsg.timestamp_ms,
                                         .packet_id = pkt.id,
                                         .lifecycle_id = pkt.lifecycle_id};
@@ -1,59 +1,149 @@
 #include "edgenetswitch/packet/PacketStats.hpp"
+#include "edgenetswitch/core/CycleClock.hpp"
 #include "edgenetswitch/core/TimeUtils.hpp"
 #include "edgenetswitch/messaging/MessagingBus.hpp"
+#include <algorithm>
 #include <atomic>
+#include <bit>
 #include <iostream>
 
 namespace edgenetswitch
 {
-    void PacketStats::onTerminal(uint64_t lifecycle_id)
+    std::size_t udpBatchHistogramBucket(std::uint32_t datagram_count) noexcept
     {
-        std::lock_guard<std::mutex> lock(lifecycle_mutex_);
-        if (!completed_lifecycles_.insert(lifecycle_id).second)
+        if (datagram_count == 0)
+            return 0;
+
+        const auto bucket = static_cast<std::size_t>(std::bit_width(datagram_count) - 1);
+        return bucket < UDP_BATCH_HISTOGRAM_BUCKETS ? bucket : UDP_BATCH_HISTOGRAM_BUCKETS - 1;
+    }
+
+    PacketStats::UdpReceiverCounters *PacketStats::receiverCounters(std::uint32_t receiver_id)
+    {
+        if (receiver_id >= MAX_UDP_RECEIVERS)
+            return nullptr;
+
+        // Track the highest receiver seen so snapshots only report active receivers.
+        auto count = udp_receiver_count_.load(std::memory_order_relaxed);
+        while (count <= receiver_id &&
+               !udp_receiver_count_.compare_exchange_weak(count, receiver_id + 1,
+                                                          std::memory_order_relaxed))
+        {
+        }
+
+        return &udp_receivers_[receiver_id];
+    }
+
+    PacketStats::PacketWorkerCounters *
+    PacketStats::workerCounters(std::optional<std::uint32_t> worker_id)
+    {
+        if (!worker_id || *worker_id >= MAX_PACKET_WORKERS)
+            return nullptr;
+
+        auto count = packet_worker_count_.load(std::memory_order_relaxed);
+        while (count <= *worker_id &&
+               !packet_worker_count_.compare_exchange_weak(count, *worker_id + 1,
+                                                           std::memory_order_relaxed))
         {
-            duplicate_events_.fetch_add(1, std::memory_order_relaxed);
-            return;
         }
 
-        terminal_events_.fetch_add(1, std::memory_order_relaxed);
+        return &packet_workers_[*worker_id];
     }
 
-    PacketStats::PacketStats(MessagingBus &bus)
+    bool PacketStats::completeLifecycle(std::uint64_t lifecycle_id)
     {
+        auto &window = completed_lifecycles_[lifecycle_id % lifecycle_id_stride_];
+
+        switch (window.mark(lifecycle_id / lifecycle_id_stride_))
+        {
+        case LifecycleMark::Duplicate:
+            counters_.add(DuplicateEvents);
+            return false;
+        case LifecycleMark::TooOld:
+            counters_.add(StaleLifecycleEvents);
+            break;
+        case LifecycleMark::New:
+            break;
+        }
+
+        counters_.add(TerminalEvents);
+        return true;
+    }
+
+    void PacketStats::onTerminal(uint64_t lifecycle_id)
+    {
+        completeLifecycle(lifecycle_id);
+    }
+
+    PacketStats::PacketStats(MessagingBus &bus, const PacketBufferPool *buffer_pool,
+                             std::uint32_t lifecycle_id_stride)
+        : lifecycle_id_stride_(std::max<std::uint32_t>(lifecycle_id_stride, 1)),
+          completed_lifecycles_(std::make_unique<LifecycleDedupWindow[]>(lifecycle_id_stride_)),
+          stage_latency_(std::make_unique<StageHistograms[]>(MAX_PACKET_WORKERS + 1)),
+          buffer_pool_(buffer_pool)
+    {
+        // Calibrate the stage clock now rather than on the first processed packet.
+        CycleClock::nsPerTick();
+
         bus.subscribe(
             MessageType::PacketProcessed,
             [this](const Message &msg)
             {
                 const Packet &p = std::get<Packet>(msg.payload);
 
-                std::lock_guard<std::mutex> lock(lifecycle_mutex_);
-                if (!completed_lifecycles_.insert(p.lifecycle_id).second)
-                {
-                    duplicate_events_.fetch_add(1, std::memory_order_relaxed);
+                if (!completeLifecycle(p.lifecycle_id))
                     return;
-                }
 
-                rx_packets_.fetch_add(1, std::memory_order_relaxed);
-                rx_bytes_.fetch_add(p.payload_size, std::memory_order_relaxed);
-                processed_packets_.fetch_add(1, std::memory_order_relaxed);
-                terminal_events_.fetch_add(1, std::memory_order_relaxed);
+                counters_.add(RxPackets);
+                counters_.add(RxBytes, p.payload_size);
+                counters_.add(ProcessedPackets);
 
                 const auto now_ns = nowNs();
+                auto *worker = workerCounters(p.processor_worker);
 
                 if (p.ingress_timestamp_ns != 0 && now_ns >= p.ingress_timestamp_ns)
                 {
                     const auto latency_ns = now_ns - p.ingress_timestamp_ns;
 
-                    total_processing_latency_ns_.fetch_add(latency_ns, std::memory_order_relaxed);
+                    // Each worker records into its own histogram; snapshots merge them.
+                    if (worker)
+                        worker->processing_latency.record(latency_ns);
+                    else
+                        unattributed_latency_.record(latency_ns);
+
+                    counters_.add(TotalProcessingLatencyNs, latency_ns);
+                    counters_.add(LatencySamples);
+
+                    // Every worker publishes PacketProcessed, so the global max needs a CAS.
+                    auto current_max = max_processing_latency_ns_.load(std::memory_order_relaxed);
+                    while (latency_ns > current_max &&
+                           !max_processing_latency_ns_.compare_exchange_weak(
+                               current_max, latency_ns, std::memory_order_relaxed))
+                    {
+                    }
+                }
+
+                auto &stage_histograms =
+                    stage_latency_[worker ? *p.processor_worker : MAX_PACKET_WORKERS];
 
-                    latency_samples_.fetch_add(1, std::memory_order_relaxed);
+                for (std::size_t stage = 0; stage < PIPELINE_STAGE_COUNT; ++stage)
+                {
+                    if (const auto ns = p.stages.stageNs(static_cast<PipelineStage>(stage)))
+                        stage_histograms[stage].record(*ns);
+                }
 
-                    const auto current_max =
-                        max_processing_latency_ns_.load(std::memory_order_relaxed);
+                if (worker)
+                {
+                    worker->processed_packets.fetch_add(1, std::memory_order_relaxed);
 
-                    if (latency_ns > current_max)
+                    if (p.worker_enqueue_ns != 0 && now_ns >= p.worker_enqueue_ns)
                     {
-                        max_processing_latency_ns_.store(latency_ns, std::memory_order_relaxed);
+                        const auto latency_ns = now_ns - p.worker_enqueue_ns;
+                        worker->total_latency_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+
+                        // Only the owning worker writes its own max, so this one needs no CAS.
+                        if (latency_ns > worker->max_latency_ns.load(std::memory_order_relaxed))
+                            worker->max_latency_ns.store(latency_ns, std::memory_order_relaxed);
                     }
                 }
             });
@@ -63,15 +153,21 @@ namespace edgenetswitch
                       {
                           const auto drop = std::get<PacketDropped>(msg.payload);
 
-                          std::lock_guard<std::mutex> lock(lifecycle_mutex_);
-                          if (!completed_lifecycles_.insert(drop.lifecycle_id).second)
-                          {
-                              duplicate_events_.fetch_add(1, std::memory_order_relaxed);
+                          if (!completeLifecycle(drop.lifecycle_id))
                               return;
-                          }
 
-                          drop_counters_[drop.reason].fetch_add(1, std::memory_order_relaxed);
-                          terminal_events_.fetch_add(1, std::memory_order_relaxed);
+                          auto &source_counters = drop_counters_[dropSourceIndex(drop.source)];
+                          source_counters[dropReasonIndex(drop.reason)].value.fetch_add(
+                              1, std::memory_order_relaxed);
+
+                          if (auto *worker = workerCounters(drop.processor_worker))
+                          {
+                              worker->drops.fetch_add(1, std::memory_order_relaxed);
+
+                              if (drop.reason == PacketDropReason::QueueOverflow)
+                                  worker->queue_overflow_drops.fetch_add(
+                                      1, std::memory_order_relaxed);
+                          }
                       });
 
         bus.subscribe(MessageType::PacketRx,
@@ -84,32 +180,117 @@ namespace edgenetswitch
                               std::cerr << "[PacketStats] invalid PacketRx payload\n";
                               return;
                           }
-                          ingress_packets_.fetch_add(1, std::memory_order_relaxed);
+                          counters_.add(IngressPackets);
+
+                          if (p->ingress_receiver)
+                          {
+                              if (auto *receiver = receiverCounters(*p->ingress_receiver))
+                                  receiver->ingress_packets.fetch_add(1, std::memory_order_relaxed);
+                          }
+                      });
+        bus.subscribe(MessageType::IngressIdlePoll,
+                      [this](const Message &msg)
+                      {
+                          counters_.add(UdpDrainCompletions);
+
+                          const auto *poll = std::get_if<IngressIdlePoll>(&msg.payload);
+                          if (!poll)
+                              return;
+
+                          if (auto *receiver = receiverCounters(poll->receiver_id))
+                              receiver->drain_completions.fetch_add(1, std::memory_order_relaxed);
+                      });
+        bus.subscribe(MessageType::IngressBatchReceived,
+                      [this](const Message &msg)
+                      {
+                          const auto *batch = std::get_if<IngressBatchReceived>(&msg.payload);
+
+                          if (!batch)
+                              return;
+
+                          counters_.add(UdpBatches);
+                          counters_.add(UdpBatchHistogramFirst +
+                                        udpBatchHistogramBucket(batch->datagram_count));
+
+                          if (auto *receiver = receiverCounters(batch->receiver_id))
+                              receiver->batches.fetch_add(1, std::memory_order_relaxed);
                       });
-        bus.subscribe(MessageType::IngressIdlePoll, [this](const Message &msg)
-                      { udp_drain_completions_.fetch_add(1, std::memory_order_relaxed); });
     }
 
-    PacketMetrics PacketStats::snapshotAt(std::uint64_t now_ms) const
+    LatencyDistribution PacketStats::processingLatency() const
     {
-        const std::uint64_t current_packets = rx_packets_.load(std::memory_order_relaxed);
-        const std::uint64_t current_bytes = rx_bytes_.load(std::memory_order_relaxed);
-        const std::uint64_t ingress_packets = ingress_packets_.load(std::memory_order_relaxed);
+        LatencyDistribution distribution;
+        unattributed_latency_.mergeInto(distribution);
 
-        std::uint64_t processed_packets = 0;
-        std::uint64_t terminal_events = 0;
-        std::uint64_t duplicate_events = 0;
-        std::unordered_map<PacketDropReason, std::uint64_t> drop_snapshot;
+        const auto packet_worker_count = packet_worker_count_.load(std::memory_order_relaxed);
+        for (std::uint32_t id = 0; id < packet_worker_count; ++id)
+        {
+            packet_workers_[id].processing_latency.mergeInto(distribution);
+        }
 
+        return distribution;
+    }
+
+    LatencyWindow PacketStats::takeProcessingLatencyWindow(std::uint64_t now_ms)
+    {
+        // Merge under the lock too, so concurrent readers never diff against a newer baseline.
+        std::lock_guard<std::mutex> lock(latency_window_mutex_);
+
+        const LatencyDistribution latency = processingLatency();
+        LatencyDistribution window = latency;
+        window.subtract(latency_window_baseline_);
+        latency_window_baseline_ = latency;
+
+        const std::uint64_t window_ms =
+            latency_window_started_ && now_ms >= latency_window_start_ms_
+                ? now_ms - latency_window_start_ms_
+                : 0;
+        latency_window_start_ms_ = now_ms;
+        latency_window_started_ = true;
+
+        return LatencyWindow{.latency = window.percentiles(), .window_ms = window_ms};
+    }
+
+    LatencyDistribution PacketStats::stageLatency(PipelineStage stage) const
+    {
+        LatencyDistribution distribution;
+        const auto index = static_cast<std::size_t>(stage);
+
+        stage_latency_[MAX_PACKET_WORKERS][index].mergeInto(distribution);
+
+        const auto packet_worker_count = packet_worker_count_.load(std::memory_order_relaxed);
+        for (std::uint32_t id = 0; id < packet_worker_count; ++id)
         {
-            std::lock_guard<std::mutex> lock(lifecycle_mutex_);
-            processed_packets = processed_packets_.load(std::memory_order_relaxed);
-            terminal_events = terminal_events_.load(std::memory_order_relaxed);
-            duplicate_events = duplicate_events_.load(std::memory_order_relaxed);
+            stage_latency_[id][index].mergeInto(distribution);
+        }
 
-            for (const auto &[reason, counter] : drop_counters_)
+        return distribution;
+    }
+
+    PacketMetrics PacketStats::snapshotAt(std::uint64_t now_ms) const
+    {
+        const auto counters = counters_.snapshot();
+
+        const std::uint64_t current_packets = counters[RxPackets];
+        const std::uint64_t current_bytes = counters[RxBytes];
+        const std::uint64_t ingress_packets = counters[IngressPackets];
+
+        const std::uint64_t processed_packets = counters[ProcessedPackets];
+        const std::uint64_t terminal_events = counters[TerminalEvents];
+        const std::uint64_t duplicate_events = counters[DuplicateEvents];
+        const std::uint64_t stale_lifecycle_events = counters[StaleLifecycleEvents];
+
+        PacketDropCounts drops_by_reason{};
+        std::array<PacketDropCounts, PACKET_DROP_SOURCE_COUNT> drops_by_source{};
+
+        for (std::size_t source = 0; source < PACKET_DROP_SOURCE_COUNT; ++source)
+        {
+            for (std::size_t reason = 0; reason < PACKET_DROP_REASON_COUNT; ++reason)
             {
-                drop_snapshot[reason] = counter.load(std::memory_order_relaxed);
+                const auto count =
+                    drop_counters_[source][reason].value.load(std::memory_order_relaxed);
+                drops_by_source[source][reason] = count;
+                drops_by_reason[reason] += count;
             }
         }
 
@@ -118,10 +299,54 @@ namespace edgenetswitch
         const std::uint64_t pending_terminal_events =
             ingress_packets > terminal_events ? ingress_packets - terminal_events : 0;
 
-        const auto total_latency = total_processing_latency_ns_.load(std::memory_order_relaxed);
+        const auto total_latency = counters[TotalProcessingLatencyNs];
         const auto max_latency = max_processing_latency_ns_.load(std::memory_order_relaxed);
-        const auto latency_samples = latency_samples_.load(std::memory_order_relaxed);
-        const auto udp_drain_completions = udp_drain_completions_.load(std::memory_order_relaxed);
+        const auto latency_samples = counters[LatencySamples];
+        const auto udp_drain_completions = counters[UdpDrainCompletions];
+        const auto udp_batches = counters[UdpBatches];
+
+        UdpBatchHistogram udp_batch_histogram{};
+        for (std::size_t bucket = 0; bucket < UDP_BATCH_HISTOGRAM_BUCKETS; ++bucket)
+        {
+            udp_batch_histogram[bucket] = counters[UdpBatchHistogramFirst + bucket];
+        }
+
+        const auto udp_receiver_count = udp_receiver_count_.load(std::memory_order_relaxed);
+        std::array<UdpReceiverMetrics, MAX_UDP_RECEIVERS> udp_receivers{};
+
+        for (std::uint32_t id = 0; id < udp_receiver_count; ++id)
+        {
+            const auto &counters = udp_receivers_[id];
+            udp_receivers[id] = UdpReceiverMetrics{
+                .ingress_packets = counters.ingress_packets.load(std::memory_order_relaxed),
+                .drain_completions = counters.drain_completions.load(std::memory_order_relaxed),
+                .batches = counters.batches.load(std::memory_order_relaxed)};
+        }
+
+        const auto packet_worker_count = packet_worker_count_.load(std::memory_order_relaxed);
+        std::array<PacketWorkerMetrics, MAX_PACKET_WORKERS> packet_workers{};
+
+        for (std::uint32_t id = 0; id < packet_worker_count; ++id)
+        {
+            const auto &counters = packet_workers_[id];
+            const auto processed = counters.processed_packets.load(std::memory_order_relaxed);
+            const auto worker_total_latency =
+                counters.total_latency_ns.load(std::memory_order_relaxed);
+
+            packet_workers[id] = PacketWorkerMetrics{
+                .processed_packets = processed,
+                .drops = counters.drops.load(std::memory_order_relaxed),
+                .queue_overflow_drops =
+                    counters.queue_overflow_drops.load(std::memory_order_relaxed),
+                .average_latency_ns = processed != 0 ? worker_total_latency / processed : 0,
+                .max_latency_ns = counters.max_latency_ns.load(std::memory_order_relaxed)};
+        }
+
+        std::array<LatencyPercentiles, PIPELINE_STAGE_COUNT> stage_latency{};
+        for (std::size_t stage = 0; stage < PIPELINE_STAGE_COUNT; ++stage)
+        {
+            stage_latency[stage] = stageLatency(static_cast<PipelineStage>(stage)).percentiles();
+        }
 
         std::uint64_t average_latency = 0;
 
@@ -134,7 +359,8 @@ namespace edgenetswitch
                              .rx_bytes = current_bytes,
                              .rx_packets_per_sec = 0,
                              .rx_bytes_per_sec = 0,
-                             .drops_by_reason = std::move(drop_snapshot),
+                             .drops_by_reason = drops_by_reason,
+                             .drops_by_source = drops_by_source,
                              .rx_packets_per_sec_raw = 0,
                              .rx_bytes_per_sec_raw = 0,
                              .ingress_packets = ingress_packets,
@@ -142,30 +368,42 @@ namespace edgenetswitch
                              .processing_gap = processing_gap,
                              .terminal_events = terminal_events,
                              .duplicate_events = duplicate_events,
+                             .stale_lifecycle_events = stale_lifecycle_events,
                              .pending_terminal_events = pending_terminal_events,
                              .total_processing_latency_ns = total_latency,
                              .max_processing_latency_ns = max_latency,
                              .average_processing_latency_ns = average_latency,
                              .latency_samples = latency_samples,
-                             .udp_drain_completions = udp_drain_completions};
+                             .processing_latency = processingLatency().percentiles(),
+                             .stage_latency = stage_latency,
+                             .udp_drain_completions = udp_drain_completions,
+                             .udp_batches = udp_batches,
+                             .udp_batch_histogram = udp_batch_histogram,
+                             .udp_receiver_count = udp_receiver_count,
+                             .udp_receivers = udp_receivers,
+                             .packet_worker_count = packet_worker_count,
+                             .packet_workers = packet_workers,
+                             .buffer_pool_capacity = buffer_pool_ ? buffer_pool_->capacity() : 0,
+                             .buffer_pool_in_use = buffer_pool_ ? buffer_pool_->inUse() : 0};
     }
 
     std::uint64_t PacketStats::rxPackets() const
     {
-        return rx_packets_.load(std::memory_order_relaxed);
+        return counters_.load(RxPackets);
     }
 
     std::uint64_t PacketStats::rxBytes() const
     {
-        return rx_bytes_.load(std::memory_order_relaxed);
+        return counters_.load(RxBytes);
     }
 
     std::uint64_t PacketStats::drops() const
     {
         std::uint64_t total = 0;
-        for (const auto &[_, counter] : drop_counters_)
+        for (const auto &row : drop_counters_)
         {
-            total += counter.load(std::memory_order_relaxed);
+            for (const auto &counter : row)
+                total += counter.value.load(std::memory_order_relaxed);
         }
 
         return total;
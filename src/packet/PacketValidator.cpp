@@ -1,7 +1,12 @@
 #include "edgenetswitch/packet/PacketValidator.hpp"
 
-#include <algorithm>
-#include <cctype>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define EDGENETSWITCH_PAYLOAD_SCAN_X86 1
+#endif
 
 namespace edgenetswitch
 {
@@ -20,11 +25,183 @@ namespace edgenetswitch
             return "missing_source";
         case PacketRejectReason::PayloadTooLarge:
             return "payload_too_large";
+        case PacketRejectReason::NonPrintablePayload:
+            return "non_printable_payload";
+        default:
+            return "unknown";
+        }
+    }
+
+    std::string toString(PayloadScanKernel kernel)
+    {
+        switch (kernel)
+        {
+        case PayloadScanKernel::Scalar:
+            return "scalar";
+        case PayloadScanKernel::Sse2:
+            return "sse2";
+        case PayloadScanKernel::Avx2:
+            return "avx2";
         default:
             return "unknown";
         }
     }
 
+    namespace
+    {
+        void scanScalar(const unsigned char *data, std::size_t size, PayloadScan &scan) noexcept
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const unsigned char byte = data[i];
+                const bool whitespace = byte == ' ' || (byte >= '\t' && byte <= '\r');
+
+                scan.all_whitespace = scan.all_whitespace && whitespace;
+                scan.has_control = scan.has_control || (byte < 0x20 && !whitespace) || byte == 0x7F;
+            }
+        }
+
+#ifdef EDGENETSWITCH_PAYLOAD_SCAN_X86
+        // Per lane: whitespace and control masks, built from unsigned range checks
+        // (x <= limit  <=>  min_epu8(x, limit) == x).
+        PayloadScan scanSse2(const unsigned char *data, std::size_t size) noexcept
+        {
+            const __m128i space = _mm_set1_epi8(' ');
+            const __m128i tab = _mm_set1_epi8('\t');
+            const __m128i tabRange = _mm_set1_epi8('\r' - '\t');
+            const __m128i controlMax = _mm_set1_epi8(0x1F);
+            const __m128i del = _mm_set1_epi8(0x7F);
+
+            __m128i allWhitespace = _mm_set1_epi8(-1);
+            __m128i anyControl = _mm_setzero_si128();
+
+            std::size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+
+                const __m128i shifted = _mm_sub_epi8(v, tab);
+                const __m128i inTabRange =
+                    _mm_cmpeq_epi8(_mm_min_epu8(shifted, tabRange), shifted);
+                const __m128i whitespace = _mm_or_si128(_mm_cmpeq_epi8(v, space), inTabRange);
+                const __m128i belowSpace = _mm_cmpeq_epi8(_mm_min_epu8(v, controlMax), v);
+                const __m128i control = _mm_or_si128(_mm_andnot_si128(inTabRange, belowSpace),
+                                                     _mm_cmpeq_epi8(v, del));
+
+                allWhitespace = _mm_and_si128(allWhitespace, whitespace);
+                anyControl = _mm_or_si128(anyControl, control);
+            }
+
+            PayloadScan scan{};
+            scan.all_whitespace = _mm_movemask_epi8(allWhitespace) == 0xFFFF;
+            scan.has_control = _mm_movemask_epi8(anyControl) != 0;
+            scanScalar(data + i, size - i, scan);
+            return scan;
+        }
+
+        __attribute__((target("avx2"))) PayloadScan scanAvx2(const unsigned char *data,
+                                                             std::size_t size) noexcept
+        {
+            const __m256i space = _mm256_set1_epi8(' ');
+            const __m256i tab = _mm256_set1_epi8('\t');
+            const __m256i tabRange = _mm256_set1_epi8('\r' - '\t');
+            const __m256i controlMax = _mm256_set1_epi8(0x1F);
+            const __m256i del = _mm256_set1_epi8(0x7F);
+
+            __m256i allWhitespace = _mm256_set1_epi8(-1);
+            __m256i anyControl = _mm256_setzero_si256();
+
+            std::size_t i = 0;
+            for (; i + 32 <= size; i += 32)
+            {
+                const __m256i v =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+
+                const __m256i shifted = _mm256_sub_epi8(v, tab);
+                const __m256i inTabRange =
+                    _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, tabRange), shifted);
+                const __m256i whitespace =
+                    _mm256_or_si256(_mm256_cmpeq_epi8(v, space), inTabRange);
+                const __m256i belowSpace =
+                    _mm256_cmpeq_epi8(_mm256_min_epu8(v, controlMax), v);
+                const __m256i control = _mm256_or_si256(
+                    _mm256_andnot_si256(inTabRange, belowSpace), _mm256_cmpeq_epi8(v, del));
+
+                allWhitespace = _mm256_and_si256(allWhitespace, whitespace);
+                anyControl = _mm256_or_si256(anyControl, control);
+            }
+
+            PayloadScan scan{};
+            scan.all_whitespace = _mm256_movemask_epi8(allWhitespace) == -1;
+            scan.has_control = _mm256_movemask_epi8(anyControl) != 0;
+            scanScalar(data + i, size - i, scan);
+            return scan;
+        }
+#endif
+
+        PayloadScanKernel detectPayloadScanKernel() noexcept
+        {
+#ifdef EDGENETSWITCH_PAYLOAD_SCAN_X86
+            if (__builtin_cpu_supports("avx2"))
+                return PayloadScanKernel::Avx2;
+
+            return PayloadScanKernel::Sse2;
+#else
+            return PayloadScanKernel::Scalar;
+#endif
+        }
+    } // namespace
+
+    bool payloadScanKernelSupported(PayloadScanKernel kernel) noexcept
+    {
+        switch (kernel)
+        {
+        case PayloadScanKernel::Scalar:
+            return true;
+        case PayloadScanKernel::Sse2:
+            return activePayloadScanKernel() != PayloadScanKernel::Scalar;
+        case PayloadScanKernel::Avx2:
+            return activePayloadScanKernel() == PayloadScanKernel::Avx2;
+        default:
+            return false;
+        }
+    }
+
+    PayloadScanKernel activePayloadScanKernel() noexcept
+    {
+        static const PayloadScanKernel kernel = detectPayloadScanKernel();
+        return kernel;
+    }
+
+    PayloadScan scanPayload(std::string_view payload) noexcept
+    {
+        return scanPayload(payload, activePayloadScanKernel());
+    }
+
+    PayloadScan scanPayload(std::string_view payload, PayloadScanKernel kernel) noexcept
+    {
+        const auto *data = reinterpret_cast<const unsigned char *>(payload.data());
+
+        if (!payloadScanKernelSupported(kernel))
+            kernel = PayloadScanKernel::Scalar;
+
+        switch (kernel)
+        {
+#ifdef EDGENETSWITCH_PAYLOAD_SCAN_X86
+        case PayloadScanKernel::Avx2:
+            return scanAvx2(data, payload.size());
+        case PayloadScanKernel::Sse2:
+            return scanSse2(data, payload.size());
+#endif
+        default:
+        {
+            PayloadScan scan{};
+            scanScalar(data, payload.size(), scan);
+            return scan;
+        }
+        }
+    }
+
     static constexpr std::size_t MAX_PAYLOAD_SIZE = 512;
 
     ValidationResult PacketValidator::validate(const Packet &packet)
@@ -32,21 +209,33 @@ namespace edgenetswitch
         if (!packet.valid)
             return {false, PacketRejectReason::InvalidFormat};
 
-        if (packet.payload.empty() || std::all_of(packet.payload.begin(), packet.payload.end(), isspace))
+        const std::string_view payload = packet.payload;
+
+        // Binary payloads carry switching traffic, so any byte is valid data; only the text
+        // format is held to printable content. One pass classifies every text byte.
+        const bool text = packet.wireFormat() == PacketWireFormat::Text;
+        const PayloadScan scan = text ? scanPayload(payload) : PayloadScan{payload.empty(), false};
+
+        if (scan.all_whitespace)
         {
             return {false, PacketRejectReason::EmptyPayload};
         }
 
-        if (packet.source_ip.empty())
+        if (packet.source_ipv4 == 0)
         {
             return {false, PacketRejectReason::MissingSource};
         }
 
-        if (packet.payload.size() > MAX_PAYLOAD_SIZE)
+        if (payload.size() > MAX_PAYLOAD_SIZE)
         {
             return {false, PacketRejectReason::PayloadTooLarge};
         }
 
+        if (scan.has_control)
+        {
+            return {false, PacketRejectReason::NonPrintablePayload};
+        }
+
         return {true, PacketRejectReason::None};
     }
 }
@@ -1,6 +1,8 @@
 #include "edgenetswitch/replay/ReplayPlayer.hpp"
 #include "edgenetswitch/messaging/MessagingBus.hpp"
 
+#include <utility>
+
 namespace edgenetswitch
 {
     ReplayPlayer::ReplayPlayer(MessagingBus &bus) : bus_(bus) {}
@@ -14,7 +16,7 @@ namespace edgenetswitch
             msg.timestamp_ms = record.packet.timestamp_ms;
             msg.payload = record.packet;
 
-            bus_.publish(msg);
+            bus_.publish(std::move(msg));
         }
     }
 } // namespace edgenetswitch
\ No newline at end of file
@@ -26,6 +26,8 @@ namespace edgenetswitch
         const auto sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
 
         ReplayRecord record = {.sequence = sequence, .packet = *packet};
+        // Records outlive the packet lifecycle, so they must not pin a pooled ingress buffer.
+        record.packet.payload.detach();
 
         std::lock_guard<std::mutex> lock(mutex_);
         records_.push_back(std::move(record));
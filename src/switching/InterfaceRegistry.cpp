@@ -1,75 +1,110 @@
 #include "edgenetswitch/switching/InterfaceRegistry.hpp"
 
+#include <stdexcept>
+#include <string>
 #include <utility>
 
 namespace edgenetswitch
 {
-    void InterfaceRegistry::addPort(SwitchPort port)
+    InterfaceRegistry::InterfaceRegistry()
+        : ports_(MAX_SWITCH_PORTS), flood_sets_(MAX_SWITCH_PORTS)
     {
-        ports_.emplace(port.id(), std::move(port));
     }
 
-    std::optional<SwitchPort> InterfaceRegistry::findPort(std::uint32_t port_id) const
+    void InterfaceRegistry::addPort(SwitchPort port)
     {
-        auto it = ports_.find(port_id);
+        const std::uint32_t id = port.id();
 
-        if (it == ports_.end())
+        if (id >= MAX_SWITCH_PORTS)
         {
-            return std::nullopt;
+            throw std::out_of_range("port id " + std::to_string(id) +
+                                    " exceeds MAX_SWITCH_PORTS");
+        }
+
+        // An existing registration is kept, matching the previous map emplace semantics.
+        if (registered_.contains(id))
+        {
+            return;
         }
 
-        return it->second;
+        ports_[id].emplace(std::move(port));
+        registered_.insert(id);
+
+        if (ports_[id]->state() == PortState::Up)
+        {
+            up_ports_.insert(id);
+            rebuildFloodSets();
+        }
     }
 
-    bool InterfaceRegistry::isUp(std::uint32_t port_id) const
+    std::optional<SwitchPort> InterfaceRegistry::findPort(std::uint32_t port_id) const
     {
-        auto port = findPort(port_id);
-
-        if (!port)
+        if (!registered_.contains(port_id))
         {
-            return false;
+            return std::nullopt;
         }
 
-        return port->state() == PortState::Up;
+        return ports_[port_id];
     }
 
-    void InterfaceRegistry::setState(std::uint32_t port_id, PortState state)
+    bool InterfaceRegistry::isUp(std::uint32_t port_id) const noexcept
     {
-        auto it = ports_.find(port_id);
+        return up_ports_.contains(port_id);
+    }
 
-        if (it == ports_.end())
+    void InterfaceRegistry::setState(std::uint32_t port_id, PortState state)
+    {
+        if (!registered_.contains(port_id))
         {
             return;
         }
 
-        it->second.setState(state);
+        ports_[port_id]->setState(state);
+
+        if (state == PortState::Up)
+            up_ports_.insert(port_id);
+        else
+            up_ports_.erase(port_id);
+
+        rebuildFloodSets();
     }
 
     std::vector<std::uint32_t> InterfaceRegistry::activePortIds() const
     {
-        std::vector<std::uint32_t> active_ports;
+        return std::vector<std::uint32_t>(up_ports_.begin(), up_ports_.end());
+    }
 
-        for (const auto &[id, port] : ports_)
+    const PortSet &InterfaceRegistry::floodSet(std::uint32_t ingress_port) const noexcept
+    {
+        // An unregistered ingress id beyond the table excludes nothing.
+        if (ingress_port >= MAX_SWITCH_PORTS)
         {
-            if (port.state() == PortState::Up)
-            {
-                active_ports.push_back(id);
-            }
+            return up_ports_;
         }
 
-        return active_ports;
+        return flood_sets_[ingress_port];
     }
 
     std::vector<SwitchPort> InterfaceRegistry::snapshot() const
     {
         std::vector<SwitchPort> snapshot;
-        snapshot.reserve(ports_.size());
+        snapshot.reserve(registered_.size());
 
-        for (const auto &entry_pair : ports_)
+        for (const std::uint32_t id : registered_)
         {
-            snapshot.push_back(entry_pair.second);
+            snapshot.push_back(*ports_[id]);
         }
 
         return snapshot;
     }
-} // namespace edgenetswitch
\ No newline at end of file
+
+    void InterfaceRegistry::rebuildFloodSets() noexcept
+    {
+        for (std::uint32_t ingress = 0; ingress < MAX_SWITCH_PORTS; ++ingress)
+        {
+            PortSet &flood = flood_sets_[ingress];
+            flood = up_ports_;
+            flood.erase(ingress);
+        }
+    }
+} // namespace edgenetswitch
@@ -29,6 +29,29 @@ namespace edgenetswitch
         return bytes_;
     }
 
+    std::uint64_t MacAddress::packed() const noexcept
+    {
+        std::uint64_t value = 0;
+
+        for (std::uint8_t byte : bytes_)
+        {
+            value = (value << 8) | byte;
+        }
+        return value;
+    }
+
+    MacAddress MacAddress::fromPacked(std::uint64_t packed) noexcept
+    {
+        Bytes bytes{};
+
+        for (std::size_t index = bytes.size(); index-- > 0;)
+        {
+            bytes[index] = static_cast<std::uint8_t>(packed & 0xFF);
+            packed >>= 8;
+        }
+        return MacAddress(bytes);
+    }
+
     bool MacAddress::isBroadcast() const noexcept
     {
         for (std::uint8_t byte : bytes_)
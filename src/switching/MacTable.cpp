@@ -1,13 +1,327 @@
 #include "edgenetswitch/switching/MacTable.hpp"
 #include "edgenetswitch/switching/MacAddress.hpp"
 #include "edgenetswitch/switching/MacTableEntry.hpp"
+#include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <stdexcept>
+#include <thread>
 
 namespace edgenetswitch
 {
-    MacTable::MacTable(std::size_t capacity) : capacity_(capacity) {}
+    // Shard versions observed by one read attempt. Linear probing walks shards in order, so
+    // only a shard change needs recording; long chains spill into a heap vector.
+    class MacTable::ShardReadSet
+    {
+    public:
+        explicit ShardReadSet(const std::atomic<std::uint32_t> *versions) : versions_(versions)
+        {
+        }
+
+        // Returns false if the shard is being written; the attempt must then restart.
+        bool enter(std::size_t shard)
+        {
+            if (count_ != 0 && last_shard_ == shard)
+                return true;
+
+            const std::uint32_t version = versions_[shard].load(std::memory_order_acquire);
+            if ((version & 1u) != 0)
+                return false;
+
+            last_shard_ = shard;
+
+            if (count_ < inline_.size())
+                inline_[count_] = {shard, version};
+            else
+                spilled_.push_back({shard, version});
+
+            ++count_;
+            return true;
+        }
+
+        [[nodiscard]]
+        bool validate() const noexcept
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            for (std::size_t i = 0; i < count_; ++i)
+            {
+                const Observed &observed =
+                    i < inline_.size() ? inline_[i] : spilled_[i - inline_.size()];
+
+                if (versions_[observed.shard].load(std::memory_order_relaxed) != observed.version)
+                    return false;
+            }
+            return true;
+        }
+
+        void reset() noexcept
+        {
+            count_ = 0;
+            spilled_.clear();
+        }
+
+    private:
+        struct Observed
+        {
+            std::size_t shard{0};
+            std::uint32_t version{0};
+        };
+
+        const std::atomic<std::uint32_t> *versions_;
+        std::array<Observed, 8> inline_{};
+        std::vector<Observed> spilled_;
+        std::size_t count_{0};
+        std::size_t last_shard_{0};
+    };
+
+    MacTable::MacTable(std::size_t capacity) : capacity_(capacity)
+    {
+        wheel_heads_.fill(NoSlot);
+
+        if (capacity_ == 0)
+            return;
+
+        const std::size_t slot_count = std::max<std::size_t>(
+            8, std::bit_ceil(capacity_ + (capacity_ + 1) / 2));
+
+        if (slot_count >= NoSlot)
+            throw std::length_error("MacTable capacity exceeds slot index range");
+
+        slot_count_ = slot_count;
+        mask_ = slot_count - 1;
+        shift_ = 64 - static_cast<unsigned>(std::countr_zero(slot_count));
+
+        cells_ = std::make_unique<Cell[]>(slot_count);
+        links_.resize(slot_count);
+
+        const std::size_t shard_count = (slot_count + ShardSlots - 1) / ShardSlots;
+        shard_versions_ = std::make_unique<std::atomic<std::uint32_t>[]>(shard_count);
+        // A write opens each shard at most once, so openShard() never reallocates.
+        open_shards_.reserve(shard_count);
+    }
+
+    std::uint64_t MacTable::keyAt(std::size_t index) const noexcept
+    {
+        return cells_[index].key.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t MacTable::tickAt(std::size_t index) const noexcept
+    {
+        return cells_[index].last_seen_tick.load(std::memory_order_relaxed);
+    }
+
+    void MacTable::storeCell(std::size_t index, std::uint64_t key, std::uint64_t tick,
+                             std::uint32_t port_id) noexcept
+    {
+        Cell &cell = cells_[index];
+        cell.key.store(key, std::memory_order_relaxed);
+        cell.last_seen_tick.store(tick, std::memory_order_relaxed);
+        cell.port_id.store(port_id, std::memory_order_relaxed);
+    }
+
+    void MacTable::openShard(std::size_t index) noexcept
+    {
+        const std::size_t shard = index >> ShardBits;
+        auto &version = shard_versions_[shard];
+        const std::uint32_t current = version.load(std::memory_order_relaxed);
+
+        if ((current & 1u) != 0)
+            return; // already opened by this write
+
+        version.store(current + 1, std::memory_order_relaxed);
+        // Orders the odd version before the cell stores that follow (seqlock writer side).
+        std::atomic_thread_fence(std::memory_order_release);
+        open_shards_.push_back(static_cast<std::uint32_t>(shard));
+    }
+
+    void MacTable::closeShards() noexcept
+    {
+        for (const std::uint32_t shard : open_shards_)
+        {
+            auto &version = shard_versions_[shard];
+            version.store(version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+        open_shards_.clear();
+    }
+
+    std::size_t MacTable::home(std::uint64_t key) const noexcept
+    {
+        // Fibonacci hashing: the top bits of the product mix all 48 MAC bits, so vendor
+        // prefixes shared by many addresses do not cluster into neighbouring slots.
+        return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> shift_);
+    }
+
+    std::size_t MacTable::find(std::uint64_t key) const noexcept
+    {
+        // Writer-side probe: no other thread mutates cells, so no validation is needed.
+        if (slot_count_ == 0)
+            return slot_count_;
+
+        for (std::size_t index = home(key);; index = (index + 1) & mask_)
+        {
+            const std::uint64_t slot_key = keyAt(index);
+
+            if (slot_key == key)
+                return index;
+
+            if (slot_key == EmptyKey)
+                return slot_count_;
+        }
+    }
+
+    void MacTable::unlink(std::size_t index) noexcept
+    {
+        Links &slot = links_[index];
+
+        if (slot.newer != NoSlot)
+            links_[slot.newer].older = slot.older;
+        else
+            lru_head_ = slot.older;
+
+        if (slot.older != NoSlot)
+            links_[slot.older].newer = slot.newer;
+        else
+            lru_tail_ = slot.newer;
+
+        slot.newer = NoSlot;
+        slot.older = NoSlot;
+    }
+
+    void MacTable::pushFront(std::size_t index) noexcept
+    {
+        Links &slot = links_[index];
+        slot.newer = NoSlot;
+        slot.older = lru_head_;
+
+        if (lru_head_ != NoSlot)
+            links_[lru_head_].newer = static_cast<std::uint32_t>(index);
+        else
+            lru_tail_ = static_cast<std::uint32_t>(index);
+
+        lru_head_ = static_cast<std::uint32_t>(index);
+    }
+
+    void MacTable::wheelInsert(std::size_t index) noexcept
+    {
+        Links &slot = links_[index];
+        const std::uint64_t tick = tickAt(index);
+        std::uint16_t bucket = OverdueBucket;
+
+        if (tick >= wheel_now_)
+        {
+            // The level is the highest 6-bit digit in which the tick differs from the cursor,
+            // so an entry only needs re-bucketing when the cursor reaches its digit.
+            const std::uint64_t diff = tick ^ wheel_now_;
+            const unsigned level =
+                diff == 0 ? 0 : static_cast<unsigned>(std::bit_width(diff) - 1) / WheelBits;
+            const auto digit = static_cast<unsigned>((tick >> (level * WheelBits)) &
+                                                     (WheelSlots - 1));
+
+            bucket = static_cast<std::uint16_t>(level * WheelSlots + digit);
+            wheel_occupied_[level] |= std::uint64_t{1} << digit;
+        }
+
+        slot.wheel_bucket = bucket;
+        slot.wheel_prev = NoSlot;
+        slot.wheel_next = wheel_heads_[bucket];
+
+        if (slot.wheel_next != NoSlot)
+            links_[slot.wheel_next].wheel_prev = static_cast<std::uint32_t>(index);
+
+        wheel_heads_[bucket] = static_cast<std::uint32_t>(index);
+    }
+
+    void MacTable::wheelRemove(std::size_t index) noexcept
+    {
+        Links &slot = links_[index];
+
+        if (slot.wheel_prev != NoSlot)
+            links_[slot.wheel_prev].wheel_next = slot.wheel_next;
+        else
+            wheel_heads_[slot.wheel_bucket] = slot.wheel_next;
+
+        if (slot.wheel_next != NoSlot)
+            links_[slot.wheel_next].wheel_prev = slot.wheel_prev;
+
+        if (slot.wheel_bucket != OverdueBucket && wheel_heads_[slot.wheel_bucket] == NoSlot)
+        {
+            wheel_occupied_[slot.wheel_bucket / WheelSlots] &=
+                ~(std::uint64_t{1} << (slot.wheel_bucket % WheelSlots));
+        }
+
+        slot.wheel_prev = NoSlot;
+        slot.wheel_next = NoSlot;
+    }
+
+    void MacTable::moveSlot(std::size_t from, std::size_t to) noexcept
+    {
+        // Relocating an entry changes its slot index, so repoint its LRU and wheel neighbours.
+        openShard(to);
+        storeCell(to, keyAt(from), tickAt(from),
+                  cells_[from].port_id.load(std::memory_order_relaxed));
+        links_[to] = links_[from];
+
+        const Links &slot = links_[to];
+        const auto index = static_cast<std::uint32_t>(to);
+
+        if (slot.newer != NoSlot)
+            links_[slot.newer].older = index;
+        else
+            lru_head_ = index;
+
+        if (slot.older != NoSlot)
+            links_[slot.older].newer = index;
+        else
+            lru_tail_ = index;
+
+        if (slot.wheel_prev != NoSlot)
+            links_[slot.wheel_prev].wheel_next = index;
+        else
+            wheel_heads_[slot.wheel_bucket] = index;
+
+        if (slot.wheel_next != NoSlot)
+            links_[slot.wheel_next].wheel_prev = index;
+    }
+
+    void MacTable::eraseAt(std::size_t index) noexcept
+    {
+        unlink(index);
+        wheelRemove(index);
+
+        // Backward-shift deletion: pull later members of the probe chain into the hole until
+        // an empty slot or an entry already at its home position ends the chain. Every shard
+        // touched stays odd until the chain is settled, so readers never see a half-shifted
+        // chain.
+        openShard(index);
+        std::size_t hole = index;
+
+        for (std::size_t next = (hole + 1) & mask_;; next = (next + 1) & mask_)
+        {
+            const std::uint64_t key = keyAt(next);
+
+            if (key == EmptyKey)
+                break;
+
+            const std::size_t desired = home(key);
+
+            // Move the entry only if its home does not lie cyclically in (hole, next].
+            if (((next - desired) & mask_) >= ((next - hole) & mask_))
+            {
+                moveSlot(next, hole);
+                hole = next;
+            }
+        }
+
+        openShard(hole);
+        storeCell(hole, EmptyKey, 0, 0);
+        links_[hole] = Links{};
+        closeShards();
+
+        size_.store(size_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+    }
 
     void MacTable::learn(const MacAddress &mac, std::uint32_t port_id, std::uint64_t tick)
     {
@@ -15,77 +329,301 @@ namespace edgenetswitch
         if (capacity_ == 0)
             return;
 
-        auto it = entries_.find(mac);
+        const std::uint64_t key = mac.packed();
+        const std::size_t existing = find(key);
 
-        if (it != entries_.end())
+        if (existing != slot_count_)
         {
-            it->second.port_id = port_id;
-            it->second.last_seen_tick = tick;
+            const bool tick_changed = tickAt(existing) != tick;
+
+            if (tick_changed)
+                wheelRemove(existing);
+
+            openShard(existing);
+            cells_[existing].port_id.store(port_id, std::memory_order_relaxed);
+            cells_[existing].last_seen_tick.store(tick, std::memory_order_relaxed);
+            closeShards();
+
+            if (tick_changed)
+                wheelInsert(existing);
+
+            if (existing != lru_head_)
+            {
+                unlink(existing);
+                pushFront(existing);
+            }
             return;
         }
 
-        if (entries_.size() >= capacity_)
+        if (size_.load(std::memory_order_relaxed) >= capacity_)
         {
-            auto oldest = entries_.begin();
+            eraseAt(lru_tail_);
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
 
-            for (auto candidate = entries_.begin(); candidate != entries_.end(); ++candidate)
+        std::size_t index = home(key);
+        while (keyAt(index) != EmptyKey)
+        {
+            index = (index + 1) & mask_;
+        }
+
+        openShard(index);
+        storeCell(index, key, tick, port_id);
+        closeShards();
+
+        pushFront(index);
+        wheelInsert(index);
+        size_.store(size_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::optional<std::uint32_t> MacTable::lookup(const MacAddress &mac) const
+    {
+        if (slot_count_ == 0)
+            return std::nullopt;
+
+        const std::uint64_t key = mac.packed();
+        ShardReadSet read_set(shard_versions_.get());
+
+        while (true)
+        {
+            read_set.reset();
+            std::optional<std::uint32_t> result;
+            bool stable = true;
+            std::size_t index = home(key);
+
+            // A torn view can never lack an empty slot for long, but bound the walk anyway.
+            for (std::size_t probes = 0;; ++probes, index = (index + 1) & mask_)
             {
-                if (candidate->second.last_seen_tick < oldest->second.last_seen_tick)
+                if (probes == slot_count_ || !read_set.enter(index >> ShardBits))
+                {
+                    stable = false;
+                    break;
+                }
+
+                const std::uint64_t slot_key = keyAt(index);
+
+                if (slot_key == key)
                 {
-                    oldest = candidate;
+                    result = cells_[index].port_id.load(std::memory_order_relaxed);
+                    break;
                 }
+
+                if (slot_key == EmptyKey)
+                    break;
             }
-            entries_.erase(oldest);
+
+            if (stable && read_set.validate())
+                return result;
+
+            std::this_thread::yield();
         }
-        entries_.emplace(mac, MacTableEntry{
-                                  .mac = mac,
-                                  .port_id = port_id,
-                                  .last_seen_tick = tick,
-                              });
     }
 
-    std::optional<std::uint32_t> MacTable::lookup(const MacAddress &mac) const
+    std::size_t MacTable::ageOut(std::uint64_t current_tick, std::uint64_t max_age,
+                                 std::size_t max_expirations)
     {
-        auto it = entries_.find(mac);
+        if (current_tick <= max_age)
+            return 0;
 
-        if (it == entries_.end())
-            return std::nullopt;
-
-        return it->second.port_id;
+        // current_tick - last_seen_tick > max_age  <=>  last_seen_tick < current_tick - max_age
+        return expireBefore(current_tick - max_age, max_expirations);
     }
 
-    void MacTable::ageOut(std::uint64_t current_tick, std::uint64_t max_age)
+    std::size_t MacTable::expireBefore(std::uint64_t cutoff_tick, std::size_t max_expirations)
     {
-        auto it = entries_.begin();
+        std::size_t removed = 0;
 
-        while (it != entries_.end())
+        // Overdue entries were learned behind the cursor; only out-of-order ticks land here.
+        for (std::uint32_t index = wheel_heads_[OverdueBucket]; index != NoSlot;)
         {
-            if ((current_tick - it->second.last_seen_tick) > max_age)
+            if (tickAt(index) >= cutoff_tick)
             {
-                it = entries_.erase(it);
+                index = links_[index].wheel_next;
+                continue;
             }
-            else
+
+            if (removed == max_expirations)
+                return removed;
+
+            // eraseAt() may relocate the predecessor, so find it again by key afterwards.
+            const std::uint32_t prev = links_[index].wheel_prev;
+            const std::uint64_t prev_key = prev == NoSlot ? EmptyKey : keyAt(prev);
+            eraseAt(index);
+            ++removed;
+
+            index = prev_key == EmptyKey ? wheel_heads_[OverdueBucket]
+                                         : links_[find(prev_key)].wheel_next;
+        }
+
+        while (wheel_now_ < cutoff_tick)
+        {
+            // Stopping between buckets leaves the wheel consistent for the next call.
+            if (removed == max_expirations)
+                return removed;
+
+            // Earliest tick at which any occupied bucket becomes current. At level 0 that is
+            // the bucket's own tick; at higher levels it is the start of the bucket's range.
+            std::uint64_t next_tick = ~std::uint64_t{0};
+            unsigned next_level = 0;
+            unsigned next_digit = 0;
+            bool found = false;
+
+            for (unsigned level = 0; level < WheelLevels; ++level)
             {
-                ++it;
+                const unsigned shift = level * WheelBits;
+                const auto cursor = static_cast<unsigned>((wheel_now_ >> shift) & (WheelSlots - 1));
+                // Level 0 may hold entries for the cursor tick itself; higher levels only hold
+                // digits strictly ahead of the cursor.
+                const unsigned first = level == 0 ? cursor : cursor + 1;
+
+                if (first >= WheelSlots)
+                    continue;
+
+                const std::uint64_t pending = wheel_occupied_[level] & (~std::uint64_t{0} << first);
+                if (pending == 0)
+                    continue;
+
+                const auto digit = static_cast<unsigned>(std::countr_zero(pending));
+                const unsigned upper_shift = shift + WheelBits;
+                const std::uint64_t upper =
+                    upper_shift >= 64 ? 0 : (wheel_now_ >> upper_shift) << upper_shift;
+                const std::uint64_t tick = upper | (std::uint64_t{digit} << shift);
+
+                if (!found || tick < next_tick)
+                {
+                    next_tick = tick;
+                    next_level = level;
+                    next_digit = digit;
+                    found = true;
+                }
+            }
+
+            if (!found || next_tick > cutoff_tick)
+            {
+                // No bucket becomes current up to the cutoff, so jumping keeps every entry
+                // on its level.
+                wheel_now_ = cutoff_tick;
+                break;
+            }
+
+            wheel_now_ = next_tick;
+            const auto bucket = static_cast<std::uint16_t>(next_level * WheelSlots + next_digit);
+
+            if (next_level == 0)
+            {
+                // A bucket at exactly the cutoff is not yet due.
+                if (next_tick == cutoff_tick)
+                    break;
+
+                // Every entry in a level-0 bucket has exactly this tick, which is past due. The
+                // cursor stays on this bucket, so an exhausted budget resumes here next call.
+                while (wheel_heads_[bucket] != NoSlot)
+                {
+                    if (removed == max_expirations)
+                        return removed;
+
+                    eraseAt(wheel_heads_[bucket]);
+                    ++removed;
+                }
+                continue;
+            }
+
+            // Cascade: the cursor entered this bucket's range, so redistribute its entries
+            // onto lower levels relative to the new cursor.
+            while (wheel_heads_[bucket] != NoSlot)
+            {
+                const std::uint32_t index = wheel_heads_[bucket];
+                wheelRemove(index);
+                wheelInsert(index);
             }
         }
+
+        return removed;
     }
 
     std::vector<MacTableEntry> MacTable::snapshot() const
     {
         std::vector<MacTableEntry> snapshot;
+        const std::size_t shard_count = (slot_count_ + ShardSlots - 1) / ShardSlots;
+        std::vector<std::uint32_t> observed(shard_count);
 
-        for (const auto &entry_pair : entries_)
+        for (int pass = 0; pass < SnapshotPasses; ++pass)
         {
-            snapshot.push_back(entry_pair.second);
+            snapshot.clear();
+            snapshot.reserve(size_.load(std::memory_order_relaxed));
+
+            for (std::size_t shard = 0; shard < shard_count; ++shard)
+            {
+                const std::size_t first = shard * ShardSlots;
+                const std::size_t last = std::min(first + ShardSlots, slot_count_);
+                const std::size_t kept = snapshot.size();
+
+                // Per-shard seqlock read: copy, then retry the shard if the writer touched it.
+                while (true)
+                {
+                    const std::uint32_t version =
+                        shard_versions_[shard].load(std::memory_order_acquire);
+
+                    if ((version & 1u) != 0)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    for (std::size_t index = first; index < last; ++index)
+                    {
+                        const std::uint64_t key = keyAt(index);
+                        if (key == EmptyKey)
+                            continue;
+
+                        snapshot.push_back(MacTableEntry{
+                            .mac = MacAddress::fromPacked(key),
+                            .port_id = cells_[index].port_id.load(std::memory_order_relaxed),
+                            .last_seen_tick = tickAt(index),
+                        });
+                    }
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (shard_versions_[shard].load(std::memory_order_relaxed) == version)
+                    {
+                        observed[shard] = version;
+                        break;
+                    }
+
+                    snapshot.erase(snapshot.begin() + static_cast<std::ptrdiff_t>(kept),
+                                   snapshot.end());
+                }
+            }
+
+            // The dump is globally consistent if no shard changed during the whole pass.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            bool unchanged = true;
+            for (std::size_t shard = 0; shard < shard_count && unchanged; ++shard)
+            {
+                unchanged = shard_versions_[shard].load(std::memory_order_relaxed) ==
+                            observed[shard];
+            }
+
+            if (unchanged)
+                break;
         }
 
+        std::sort(snapshot.begin(), snapshot.end(),
+                  [](const MacTableEntry &lhs, const MacTableEntry &rhs)
+                  { return lhs.mac < rhs.mac; });
+
+        // An entry relocated between two shard copies can appear twice in a racy pass.
+        snapshot.erase(std::unique(snapshot.begin(), snapshot.end(),
+                                   [](const MacTableEntry &lhs, const MacTableEntry &rhs)
+                                   { return lhs.mac == rhs.mac; }),
+                       snapshot.end());
+
         return snapshot;
     }
 
     std::size_t MacTable::size() const noexcept
     {
-        return entries_.size();
+        return size_.load(std::memory_order_relaxed);
     }
 
     std::size_t MacTable::capacity() const noexcept
@@ -93,4 +631,9 @@ namespace edgenetswitch
         return capacity_;
     }
 
-} // namespace edgenetswitch
\ No newline at end of file
+    std::uint64_t MacTable::evictions() const noexcept
+    {
+        return evictions_.load(std::memory_order_relaxed);
+    }
+
+} // namespace edgenetswitch
@@ -14,28 +14,23 @@ namespace edgenetswitch
                                                              std::uint32_t ingress_port,
                                                              std::uint64_t tick)
     {
-        if (!packet.source_mac || !packet.destination_mac)
+        const auto source_mac = packet.sourceMac();
+        const auto destination_mac = packet.destinationMac();
+
+        if (!source_mac || !destination_mac)
             return {};
 
-        mac_table_.learn(*packet.source_mac, ingress_port, tick);
+        mac_table_.learn(*source_mac, ingress_port, tick);
 
         ForwardingDecision decision{};
-        if (packet.destination_mac->isBroadcast())
+        if (destination_mac->isBroadcast())
         {
             decision.action = ForwardingAction::Flood;
-
-            for (std::uint32_t port : interfaces_.activePortIds())
-            {
-                if (port == ingress_port)
-                {
-                    continue;
-                }
-                decision.egress_ports.push_back(port);
-            }
+            decision.egress_ports = interfaces_.floodSet(ingress_port);
             return decision;
         }
 
-        auto destination_port = mac_table_.lookup(*packet.destination_mac);
+        auto destination_port = mac_table_.lookup(*destination_mac);
 
         if (destination_port)
         {
@@ -46,25 +41,23 @@ namespace edgenetswitch
             }
 
             decision.action = ForwardingAction::ForwardToPorts;
-            decision.egress_ports.push_back(*destination_port);
+            decision.egress_ports.insert(*destination_port);
 
             return decision;
         }
 
         decision.action = ForwardingAction::Flood;
-
-        for (std::uint32_t port : interfaces_.activePortIds())
-        {
-            if (port == ingress_port)
-            {
-                continue;
-            }
-            decision.egress_ports.push_back(port);
-        }
+        decision.egress_ports = interfaces_.floodSet(ingress_port);
 
         return decision;
     }
 
+    std::size_t SwitchForwardingEngine::ageMacTable(std::uint64_t tick, std::uint64_t max_age,
+                                                    std::size_t max_expirations)
+    {
+        return mac_table_.ageOut(tick, max_age, max_expirations);
+    }
+
     const MacTable &SwitchForwardingEngine::macTable() const noexcept
     {
         return mac_table_;
@@ -8,7 +8,7 @@ namespace edgenetswitch
 
     void UdpReadyHandler::onEvent(const EpollEvent &)
     {
-        Logger::debug("[EPOLL] UDP readable");
+        EDGENETSWITCH_LOG_DEBUG("[EPOLL] UDP readable");
         receiver_.processReadableEvent();
     }
 } // namespace edgenetswitch
@@ -3,6 +3,7 @@
 #include "edgenetswitch/system/fd/FdState.hpp"
 #include "edgenetswitch/system/fd/FdType.hpp"
 #include <mutex>
+#include <utility>
 #include <vector>
 
 namespace edgenetswitch
@@ -26,6 +27,18 @@ namespace edgenetswitch
         it->second.state = state;
     }
 
+    void FdRegistry::setLabel(int fd, std::string label)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = records_.find(fd);
+
+        if (it == records_.end())
+            return;
+
+        it->second.label = std::move(label);
+    }
+
     void FdRegistry::unregisterFd(int fd)
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -11,7 +11,7 @@ namespace edgenetswitch::telemetry
     {
         if (!out_.is_open())
         {
-            Logger::error("FileTelemetryExporter: failed to open file: " + filePath_);
+            EDGENETSWITCH_LOG_ERROR("FileTelemetryExporter: failed to open file: " + filePath_);
         }
     }
 
@@ -42,7 +42,8 @@ namespace edgenetswitch::telemetry
 
         if (!out_)
         {
-            Logger::error("FileTelemetryExporter: failed to write sample to file: " + filePath_);
+            EDGENETSWITCH_LOG_ERROR("FileTelemetryExporter: failed to write sample to file: " +
+                                    filePath_);
             out_.clear();
         }
     }
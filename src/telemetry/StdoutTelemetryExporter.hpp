@@ -10,9 +10,9 @@ namespace edgenetswitch
     public:
         void exportSample(const RuntimeMetrics &sample) override
         {
-            Logger::info(
-                "telemetry_export: uptime_ms=" + std::to_string(sample.uptime_ms) +
-                " tick_count=" + std::to_string(sample.tick_count));
+            EDGENETSWITCH_LOG_INFO("telemetry_export: uptime_ms=" +
+                                   std::to_string(sample.uptime_ms) +
+                                   " tick_count=" + std::to_string(sample.tick_count));
         }
     };
 } // namespace edgenetswitch
\ No newline at end of file
@@ -7,7 +7,7 @@ namespace edgenetswitch::telemetry
     {
         if (!exporter)
         {
-            Logger::warn("telemetry_export: null exporter ignored");
+            EDGENETSWITCH_LOG_WARN("telemetry_export: null exporter ignored");
             return;
         }
         exporters_.push_back(std::move(exporter));
@@ -23,11 +23,11 @@ namespace edgenetswitch::telemetry
             }
             catch (const std::exception &e)
             {
-                Logger::error("Telemetry exporter failed: " + std::string(e.what()));
+                EDGENETSWITCH_LOG_ERROR("Telemetry exporter failed: " + std::string(e.what()));
             }
             catch (...)
             {
-                Logger::error("Telemetry exporter failed with unknown exception");
+                EDGENETSWITCH_LOG_ERROR("Telemetry exporter failed with unknown exception");
             }
         }
     }
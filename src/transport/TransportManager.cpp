@@ -17,8 +17,8 @@ namespace edgenetswitch::transport
 
         if (it == backends_.end())
         {
-            ++counters_.backend_unavailable;
-            ++counters_.tx_failed;
+            counters_.add(BackendUnavailable);
+            counters_.add(TxFailed);
             return {.status = TransmitStatus::BackendUnavailable, .port_id = port_id};
         }
 
@@ -27,39 +27,46 @@ namespace edgenetswitch::transport
         switch (result.status)
         {
         case TransmitStatus::Success:
-            ++counters_.tx_packets;
-            counters_.tx_bytes += result.bytes_transmitted;
+            counters_.add(TxPackets);
+            counters_.add(TxBytes, result.bytes_transmitted);
             break;
         case TransmitStatus::PortDown:
-            ++counters_.tx_failed;
-            ++counters_.port_down;
+            counters_.add(TxFailed);
+            counters_.add(PortDown);
             break;
         case TransmitStatus::BackendUnavailable:
-            ++counters_.tx_failed;
-            ++counters_.backend_unavailable;
+            counters_.add(TxFailed);
+            counters_.add(BackendUnavailable);
             break;
         case TransmitStatus::InvalidPacket:
-            ++counters_.tx_failed;
-            ++counters_.invalid_packet;
+            counters_.add(TxFailed);
+            counters_.add(InvalidPacket);
             break;
         case TransmitStatus::SendFailed:
-            ++counters_.tx_failed;
+            counters_.add(TxFailed);
             break;
         default:
-            ++counters_.tx_failed;
+            counters_.add(TxFailed);
             break;
         }
 
         return result;
     }
 
-    const TransportCounters &TransportManager::counters() const noexcept
+    TransportCounters TransportManager::counters() const noexcept
     {
-        return counters_;
+        const auto totals = counters_.snapshot();
+
+        return TransportCounters{.tx_packets = totals[TxPackets],
+                                 .tx_bytes = totals[TxBytes],
+                                 .tx_failed = totals[TxFailed],
+                                 .backend_unavailable = totals[BackendUnavailable],
+                                 .port_down = totals[PortDown],
+                                 .invalid_packet = totals[InvalidPacket]};
     }
 
     void TransportManager::resetCounters()
     {
-        counters_ = {};
+        counters_.reset();
     }
 } // namespace edgenetswitch::transport
@@ -51,8 +51,9 @@ namespace edgenetswitch::transport
                     .native_error = errno};
         }
 
-        Logger::info("UdpPortBackend: transmitted " + std::to_string(bytes_sent) + " bytes to " +
-                     endpoint_.ip + ":" + std::to_string(endpoint_.port));
+        EDGENETSWITCH_LOG_DEBUG("UdpPortBackend: transmitted " + std::to_string(bytes_sent) +
+                                " bytes to " + endpoint_.ip + ":" +
+                                std::to_string(endpoint_.port));
 
         return {.status = TransmitStatus::Success,
                 .port_id = port_id_,
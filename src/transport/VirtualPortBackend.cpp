@@ -5,7 +5,7 @@ namespace edgenetswitch::transport
 {
     TransmitResult VirtualPortBackend::transmit(const Packet &)
     {
-        Logger::debug("VirtualPortBackend: transmit() called");
+        EDGENETSWITCH_LOG_DEBUG("VirtualPortBackend: transmit() called");
         return {.status = TransmitStatus::Success};
     }
 } // namespace edgenetswitch::transport
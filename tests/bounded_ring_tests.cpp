@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "edgenetswitch/core/BoundedRing.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace edgenetswitch;
+
+TEST_CASE("BoundedRing rejects capacities that are not a power of two", "[BoundedRing]")
+{
+    REQUIRE_THROWS_AS(BoundedRing<int>(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(BoundedRing<int>(3), std::invalid_argument);
+    REQUIRE_NOTHROW(BoundedRing<int>(4));
+}
+
+TEST_CASE("BoundedRing preserves FIFO order and reports full", "[BoundedRing]")
+{
+    BoundedRing<std::string> ring(4, RingProducerMode::Single);
+
+    REQUIRE(ring.empty());
+    REQUIRE(ring.tryPush(std::string("a")));
+    REQUIRE(ring.tryPush(std::string("b")));
+    REQUIRE(ring.tryPush(std::string("c")));
+    REQUIRE(ring.tryPush(std::string("d")));
+
+    std::string overflow = "e";
+    REQUIRE_FALSE(ring.tryPush(overflow));
+    REQUIRE(overflow == "e");
+    REQUIRE(ring.sizeApprox() == 4);
+
+    std::string out;
+    REQUIRE(ring.tryPop(out));
+    REQUIRE(out == "a");
+    REQUIRE(ring.tryPush(std::string("e")));
+
+    for (const char *expected : {"b", "c", "d", "e"})
+    {
+        REQUIRE(ring.tryPop(out));
+        REQUIRE(out == expected);
+    }
+
+    REQUIRE_FALSE(ring.tryPop(out));
+    REQUIRE(ring.empty());
+}
+
+TEST_CASE("BoundedRing SPSC hands over every element in order", "[BoundedRing]")
+{
+    constexpr std::uint64_t count = 20000;
+    BoundedRing<std::uint64_t> ring(64, RingProducerMode::Single);
+
+    std::thread producer(
+        [&]
+        {
+            for (std::uint64_t i = 0; i < count; ++i)
+            {
+                while (!ring.tryPush(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    std::uint64_t expected = 0;
+    std::uint64_t value = 0;
+    while (expected < count)
+    {
+        if (!ring.tryPop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        REQUIRE(value == expected);
+        ++expected;
+    }
+
+    producer.join();
+    REQUIRE(ring.empty());
+}
+
+TEST_CASE("BoundedRing MPSC delivers each element exactly once", "[BoundedRing]")
+{
+    constexpr std::uint64_t producers = 4;
+    constexpr std::uint64_t per_producer = 5000;
+    BoundedRing<std::uint64_t> ring(128, RingProducerMode::Multi);
+
+    std::vector<std::thread> threads;
+    for (std::uint64_t p = 0; p < producers; ++p)
+    {
+        threads.emplace_back(
+            [&, p]
+            {
+                for (std::uint64_t i = 0; i < per_producer; ++i)
+                {
+                    // Encode producer id in the high bits so per-producer order can be checked.
+                    const std::uint64_t value = (p << 32) | i;
+                    while (!ring.tryPush(value))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    std::vector<std::uint64_t> next(producers, 0);
+    std::uint64_t received = 0;
+    std::uint64_t value = 0;
+
+    while (received < producers * per_producer)
+    {
+        if (!ring.tryPop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const auto p = value >> 32;
+        const auto i = value & 0xFFFFFFFFu;
+        REQUIRE(p < producers);
+        REQUIRE(i == next[p]);
+        ++next[p];
+        ++received;
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(ring.empty());
+}
@@ -96,6 +96,110 @@ TEST_CASE("ConfigLoader applies defaults when fields are missing", "[Config]")
     REQUIRE(cfg.log.level == "info");             // default
     REQUIRE(cfg.log.file == "edgenetswitch.log"); // default
     REQUIRE(cfg.daemon.tick_ms == 100);           // default
+    REQUIRE(cfg.udp.batch_size == 32);            // default
+    REQUIRE(cfg.udp.receivers == 1);              // default
+    REQUIRE(cfg.udp.buffer_pool_slabs == 4096);   // default
+    REQUIRE(cfg.processor.workers == 1);          // default
+    REQUIRE(cfg.switching.mac_age_ms == 300000);  // default
+}
+
+TEST_CASE("ConfigLoader rejects udp receiver counts outside the supported range", "[Config]")
+{
+    TempDir tmp;
+    fs::path cfgPath = tmp.path / "edgenetswitch.json";
+
+    writeFile(cfgPath,
+              R"({
+            "udp": {
+                "receivers": 0
+            }
+        })");
+
+    REQUIRE_THROWS_AS(
+        core::ConfigLoader::loadFromFile(cfgPath.string()),
+        std::runtime_error);
+
+    writeFile(cfgPath,
+              R"({
+            "udp": {
+                "receivers": 64
+            }
+        })");
+
+    REQUIRE_THROWS_AS(
+        core::ConfigLoader::loadFromFile(cfgPath.string()),
+        std::runtime_error);
+}
+
+TEST_CASE("ConfigLoader rejects processor worker counts outside the supported range", "[Config]")
+{
+    TempDir tmp;
+    fs::path cfgPath = tmp.path / "edgenetswitch.json";
+
+    writeFile(cfgPath,
+              R"({
+            "processor": {
+                "workers": 0
+            }
+        })");
+
+    REQUIRE_THROWS_AS(
+        core::ConfigLoader::loadFromFile(cfgPath.string()),
+        std::runtime_error);
+
+    writeFile(cfgPath,
+              R"({
+            "processor": {
+                "workers": 64
+            }
+        })");
+
+    REQUIRE_THROWS_AS(
+        core::ConfigLoader::loadFromFile(cfgPath.string()),
+        std::runtime_error);
+
+    writeFile(cfgPath,
+              R"({
+            "processor": {
+                "workers": 4
+            }
+        })");
+
+    REQUIRE(core::ConfigLoader::loadFromFile(cfgPath.string()).processor.workers == 4);
+}
+
+TEST_CASE("ConfigLoader rejects zero udp batch size", "[Config]")
+{
+    TempDir tmp;
+    fs::path cfgPath = tmp.path / "edgenetswitch.json";
+
+    writeFile(cfgPath,
+              R"({
+            "udp": {
+                "batch_size": 0
+            }
+        })");
+
+    REQUIRE_THROWS_AS(
+        core::ConfigLoader::loadFromFile(cfgPath.string()),
+        std::runtime_error);
+}
+
+TEST_CASE("ConfigLoader rejects udp batch size above the per-wakeup limit", "[Config]")
+{
+    TempDir tmp;
+    fs::path cfgPath = tmp.path / "edgenetswitch.json";
+
+    writeFile(cfgPath,
+              R"({
+            "udp": {
+                "batch_size": 257
+            }
+        })");
+
+    REQUIRE_THROWS_AS(
+        core::ConfigLoader::loadFromFile(cfgPath.string()),
+        std::runtime_error);
 }
 
 TEST_CASE("ConfigLoader throws when config file does not exist", "[Config]")
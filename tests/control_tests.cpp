@@ -5,11 +5,21 @@
 
 #include "edgenetswitch/control/ControlContext.hpp"
 #include "edgenetswitch/core/Config.hpp"
+#include "edgenetswitch/core/Logger.hpp"
+#include "edgenetswitch/core/TimeUtils.hpp"
+#include "edgenetswitch/messaging/MessagingBus.hpp"
+#include "edgenetswitch/packet/PacketStats.hpp"
 #include "edgenetswitch/control/ControlProtocol.hpp"
+#include "edgenetswitch/switching/InterfaceRegistry.hpp"
+#include "edgenetswitch/switching/MacTable.hpp"
+#include "edgenetswitch/switching/SwitchForwardingEngine.hpp"
+#include "edgenetswitch/system/fd/FdRegistry.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <chrono>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace
@@ -33,8 +43,18 @@ namespace
         s.snapshot_timestamp_ms = 1700000000123ULL;
         s.packet.rx_packets = 101;
         s.packet.rx_bytes = 202;
-        s.packet.drops_by_reason[edgenetswitch::PacketDropReason::ParseError] = 3;
-        s.packet.drops_by_reason[edgenetswitch::PacketDropReason::ValidationError] = 4;
+        using edgenetswitch::dropReasonIndex;
+        using edgenetswitch::dropSourceIndex;
+        using edgenetswitch::PacketDropReason;
+        using edgenetswitch::PacketDropSource;
+        s.packet.drops_by_reason[dropReasonIndex(PacketDropReason::ParseError)] = 3;
+        s.packet.drops_by_reason[dropReasonIndex(PacketDropReason::ValidationError)] = 4;
+        s.packet.drops_by_source[dropSourceIndex(PacketDropSource::Ingress)]
+                                [dropReasonIndex(PacketDropReason::ParseError)] = 3;
+        s.packet.drops_by_source[dropSourceIndex(PacketDropSource::Ingress)]
+                                [dropReasonIndex(PacketDropReason::ValidationError)] = 1;
+        s.packet.drops_by_source[dropSourceIndex(PacketDropSource::FailureInjector)]
+                                [dropReasonIndex(PacketDropReason::ValidationError)] = 3;
         s.packet.rx_packets_per_sec = 55;
         s.packet.rx_bytes_per_sec = 66;
         s.packet.rx_packets_per_sec_raw = 77;
@@ -215,10 +235,29 @@ TEST_CASE("JSON mode returns current command payloads", "[control][json]")
         REQUIRE(j["data"].contains("drops"));
         REQUIRE(j["data"]["drops"].contains("parse_error"));
         REQUIRE(j["data"]["drops"].contains("validation_error"));
+        CHECK_FALSE(j["data"]["drops"].contains("queue_overflow"));
+        REQUIRE(j["data"].contains("drops_by_source"));
+        const auto &by_source = j["data"]["drops_by_source"];
+        CHECK(by_source["ingress"]["parse_error"] == 3);
+        CHECK(by_source["ingress"]["validation_error"] == 1);
+        CHECK(by_source["processor"].empty());
+        CHECK(by_source["failure_injector"]["validation_error"] == 3);
         CHECK(j["data"].contains("rx_packets_per_sec"));
         CHECK(j["data"].contains("rx_bytes_per_sec"));
         CHECK(j["data"].contains("rx_packets_per_sec_raw"));
         CHECK(j["data"].contains("rx_bytes_per_sec_raw"));
+        CHECK(j["data"].contains("udp_batches"));
+        REQUIRE(j["data"].contains("udp_batch_histogram"));
+        CHECK(j["data"]["udp_batch_histogram"].contains("1"));
+        CHECK(j["data"]["udp_batch_histogram"].contains("2-3"));
+        CHECK(j["data"]["udp_batch_histogram"].contains("128+"));
+        REQUIRE(j["data"].contains("processing_latency"));
+        CHECK(j["data"]["processing_latency"].contains("p50_ns"));
+        CHECK(j["data"]["processing_latency"].contains("p99_ns"));
+        CHECK(j["data"]["processing_latency"].contains("p999_ns"));
+        REQUIRE(j["data"].contains("processing_latency_window"));
+        CHECK(j["data"]["processing_latency_window"].contains("p99_ns"));
+        CHECK(j["data"]["processing_latency_window"].contains("window_ms"));
     }
 
     SECTION("show-config json")
@@ -230,6 +269,8 @@ TEST_CASE("JSON mode returns current command payloads", "[control][json]")
         CHECK(j["data"].contains("log"));
         CHECK(j["data"].contains("daemon"));
         CHECK(j["data"].contains("udp"));
+        CHECK(j["data"].contains("processor"));
+        CHECK(j["data"].contains("switching"));
         CHECK(j["data"].contains("rate"));
     }
 }
@@ -255,7 +296,11 @@ TEST_CASE("Text mode exposes key=value output", "[control][text]")
         {"metrics", {"uptime_ms=", "tick_count="}},
         {"version", {"version=", "protocol=", "build="}},
         {"help:version", {"command=", "description="}},
-        {"packet-stats", {"rx_packets=", "rx_bytes=", "drops_total="}},
+        {"packet-stats",
+         {"rx_packets=", "rx_bytes=", "drops_parse_error=3", "drops_total=7",
+          "drops_source_ingress=4", "drops_source_failure_injector=3",
+          "processing_latency_p99_ns=", "\nterminal_events=", "\nduplicate_events=",
+          "\nstale_lifecycle_events=", "\npending_terminal_events="}},
         {"show-config", {"log.level=", "daemon.tick_ms=", "udp.port=", "rate.window_ms="}},
     };
 
@@ -321,6 +366,7 @@ TEST_CASE("show-config exposes configured fields in text and json modes", "[cont
         CHECK(contains(resp.payload, "daemon.tick_ms="));
         CHECK(contains(resp.payload, "udp.enabled="));
         CHECK(contains(resp.payload, "udp.port="));
+        CHECK(contains(resp.payload, "udp.batch_size="));
         CHECK(contains(resp.payload, "rate.alpha="));
         CHECK(contains(resp.payload, "rate.window_ms="));
     }
@@ -337,7 +383,189 @@ TEST_CASE("show-config exposes configured fields in text and json modes", "[cont
         CHECK(j["data"]["daemon"].contains("tick_ms"));
         CHECK(j["data"]["udp"].contains("enabled"));
         CHECK(j["data"]["udp"].contains("port"));
+        CHECK(j["data"]["udp"].contains("batch_size"));
         CHECK(j["data"]["rate"].contains("alpha"));
         CHECK(j["data"]["rate"].contains("window_ms"));
     }
 }
+
+TEST_CASE("fd-status lists labelled receiver sockets", "[control][fd-status]")
+{
+    edgenetswitch::FdRegistry registry;
+    registry.registerFd(40, edgenetswitch::FdState::Active, edgenetswitch::FdType::UdpSocket);
+    registry.registerFd(41, edgenetswitch::FdState::Active, edgenetswitch::FdType::UdpSocket);
+    registry.setLabel(40, "udp-rx-0");
+    registry.setLabel(41, "udp-rx-1");
+
+    const ControlContext ctx{
+        .fd_registry = &registry,
+    };
+
+    SECTION("text output contains every receiver label")
+    {
+        const auto resp = dispatch("fd-status", ctx);
+        REQUIRE(resp.success);
+        CHECK(contains(resp.payload, "fd_count=2"));
+        CHECK(contains(resp.payload, "label=udp-rx-0"));
+        CHECK(contains(resp.payload, "label=udp-rx-1"));
+    }
+
+    SECTION("json output carries labels")
+    {
+        const auto resp = dispatch("fd-status:json", ctx);
+        REQUIRE(resp.success);
+        const auto j = nlohmann::json::parse(resp.payload);
+
+        REQUIRE(j["data"]["fds"].size() == 2);
+        for (const auto &fd : j["data"]["fds"])
+        {
+            CHECK(fd.contains("label"));
+        }
+    }
+}
+
+TEST_CASE("packet-stats json latency window resets on each read", "[control][packet-stats]")
+{
+    FakeSnapshotPublisher publisher(true);
+    edgenetswitch::MessagingBus bus;
+    edgenetswitch::PacketStats stats(bus);
+    const ControlContext ctx{.publisher = publisher.ptr(), .packet_stats = &stats};
+
+    std::uint64_t next_lifecycle_id = 1;
+    const auto publishProcessed = [&](std::uint64_t count)
+    {
+        edgenetswitch::Message msg{};
+        msg.type = edgenetswitch::MessageType::PacketProcessed;
+
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            edgenetswitch::Packet packet{};
+            packet.lifecycle_id = next_lifecycle_id++;
+            packet.ingress_timestamp_ns = nowNs() - 1'000;
+            msg.payload = packet;
+            bus.publish(msg);
+        }
+    };
+
+    const auto readWindow = [&]()
+    {
+        const auto resp = dispatch("packet-stats:json", ctx);
+        REQUIRE(resp.success);
+        return nlohmann::json::parse(resp.payload)["data"]["processing_latency_window"];
+    };
+
+    publishProcessed(20);
+    const auto first = readWindow();
+    CHECK(first["count"] == 20);
+    CHECK(first["window_ms"] == 0);
+
+    publishProcessed(5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const auto second = readWindow();
+    CHECK(second["count"] == 5);
+    CHECK(second["window_ms"].get<std::uint64_t>() >= 20);
+
+    CHECK(readWindow()["count"] == 0);
+}
+
+TEST_CASE("pipeline-latency reports every stage", "[control][pipeline-latency]")
+{
+    FakeSnapshotPublisher publisher(true);
+    const ControlContext ctx{.publisher = publisher.ptr()};
+
+    SECTION("text output has one line per stage")
+    {
+        const auto resp = dispatch("pipeline-latency", ctx);
+        REQUIRE(resp.success);
+        CHECK(contains(resp.payload, "clock="));
+        CHECK(contains(resp.payload, "stage=parse_validate count=0"));
+        CHECK(contains(resp.payload, "stage=echo "));
+        CHECK(contains(resp.payload, "stage=bus_publish "));
+        CHECK(contains(resp.payload, "stage=queue_wait "));
+        CHECK(contains(resp.payload, "stage=switching "));
+        CHECK(contains(resp.payload, "stage=transport "));
+    }
+
+    SECTION("json output lists stages in pipeline order")
+    {
+        const auto resp = dispatch("pipeline-latency:json", ctx);
+        REQUIRE(resp.success);
+        const auto j = nlohmann::json::parse(resp.payload);
+        REQUIRE(j["data"]["stages"].size() == edgenetswitch::PIPELINE_STAGE_COUNT);
+        CHECK(j["data"]["stages"][0]["stage"] == "parse_validate");
+        CHECK(j["data"]["stages"][1]["stage"] == "echo");
+        CHECK(j["data"]["stages"][5]["stage"] == "transport");
+        CHECK(j["data"]["stages"][2].contains("p99_ns"));
+    }
+
+    SECTION("help lists every reported field")
+    {
+        const auto resp = dispatch("help:pipeline-latency", ctx);
+        REQUIRE(resp.success);
+        CHECK(contains(resp.payload, "p90_ns"));
+        CHECK(contains(resp.payload, "max_ns"));
+    }
+
+    SECTION("missing snapshot is an error")
+    {
+        const auto resp = dispatch("pipeline-latency", ControlContext{});
+        CHECK_FALSE(resp.success);
+    }
+}
+
+TEST_CASE("log-stats reports rate-limited log sites", "[control][log-stats]")
+{
+    LogRateLimiter limiter("control.test", 1, 1);
+    REQUIRE(limiter.allow());
+    REQUIRE_FALSE(limiter.allow());
+
+    const ControlContext ctx{};
+
+    SECTION("text output lists the site")
+    {
+        const auto resp = dispatch("log-stats", ctx);
+        REQUIRE(resp.success);
+        CHECK(contains(resp.payload, "dropped_lines="));
+        CHECK(contains(resp.payload, "site=control.test emitted=1 suppressed=1"));
+    }
+
+    SECTION("json output carries per-site counters")
+    {
+        const auto resp = dispatch("log-stats:json", ctx);
+        REQUIRE(resp.success);
+        const auto j = nlohmann::json::parse(resp.payload);
+
+        bool found = false;
+        for (const auto &site : j["data"]["sites"])
+        {
+            if (site["site"] == "control.test")
+            {
+                found = true;
+                CHECK(site["emitted"] == 1);
+                CHECK(site["suppressed"] == 1);
+            }
+        }
+        CHECK(found);
+    }
+}
+
+TEST_CASE("show:mac-table reports capacity evictions", "[control][show]")
+{
+    edgenetswitch::MacTable table(2);
+    edgenetswitch::InterfaceRegistry interfaces;
+    edgenetswitch::SwitchForwardingEngine engine(table, interfaces);
+
+    table.learn(*edgenetswitch::MacAddress::fromString("00:00:00:00:00:01"), 1, 1);
+    table.learn(*edgenetswitch::MacAddress::fromString("00:00:00:00:00:02"), 1, 2);
+    table.learn(*edgenetswitch::MacAddress::fromString("00:00:00:00:00:03"), 1, 3);
+
+    const ControlContext ctx{
+        .forwarding_engine = &engine,
+    };
+
+    const auto resp = dispatch("show:mac-table", ctx);
+    REQUIRE(resp.success);
+    CHECK(contains(resp.payload, "mac_table_size=2"));
+    CHECK(contains(resp.payload, "mac_table_evictions=1"));
+    CHECK_FALSE(contains(resp.payload, "00:00:00:00:00:01"));
+}
@@ -1,9 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "edgenetswitch/switching/InterfaceRegistry.hpp"
+#include "edgenetswitch/switching/PortSet.hpp"
 #include "edgenetswitch/switching/SwitchPort.hpp"
 
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -132,3 +134,49 @@ TEST_CASE("InterfaceRegistry snapshot returns all ports in deterministic order",
     REQUIRE(snapshot[2].name() == "eth30");
     REQUIRE(snapshot[2].state() == PortState::Up);
 }
+
+TEST_CASE("InterfaceRegistry floodSet excludes ingress and Down ports", "[InterfaceRegistry]")
+{
+    InterfaceRegistry registry;
+    registry.addPort(makePort(30, "eth30", PortState::Up));
+    registry.addPort(makePort(10, "eth10", PortState::Up));
+    registry.addPort(makePort(20, "eth20", PortState::Down));
+    registry.addPort(makePort(40, "eth40", PortState::Up));
+
+    REQUIRE(registry.floodSet(30) == PortSet{10, 40});
+    REQUIRE(registry.floodSet(99) == PortSet{10, 30, 40});
+}
+
+TEST_CASE("InterfaceRegistry rejects port ids beyond MAX_SWITCH_PORTS", "[InterfaceRegistry]")
+{
+    InterfaceRegistry registry;
+
+    REQUIRE_THROWS_AS(registry.addPort(makePort(MAX_SWITCH_PORTS, "ethX", PortState::Up)),
+                      std::out_of_range);
+    REQUIRE_FALSE(registry.findPort(MAX_SWITCH_PORTS).has_value());
+}
+
+TEST_CASE("InterfaceRegistry floodSet tracks setState and addPort", "[InterfaceRegistry]")
+{
+    InterfaceRegistry registry;
+    registry.addPort(makePort(1, "eth1", PortState::Up));
+    registry.addPort(makePort(2, "eth2", PortState::Up));
+
+    REQUIRE(registry.floodSet(1) == PortSet{2});
+
+    registry.addPort(makePort(3, "eth3", PortState::Up));
+    REQUIRE(registry.floodSet(1) == PortSet{2, 3});
+
+    registry.setState(2, PortState::Down);
+    REQUIRE(registry.floodSet(1) == PortSet{3});
+    REQUIRE(registry.floodSet(3) == PortSet{1});
+    REQUIRE_FALSE(registry.isUp(2));
+
+    registry.setState(2, PortState::Up);
+    REQUIRE(registry.floodSet(3) == PortSet{1, 2});
+
+    // Re-adding a registered id keeps the original port and state.
+    registry.addPort(makePort(2, "other", PortState::Down));
+    REQUIRE(registry.findPort(2)->name() == "eth2");
+    REQUIRE(registry.isUp(2));
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "edgenetswitch/telemetry/LatencyHistogram.hpp"
+
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace edgenetswitch;
+
+TEST_CASE("Latency buckets are exact below 64 ns and within 1/32 above", "[LatencyHistogram]")
+{
+    for (std::uint64_t value = 0; value < 64; ++value)
+    {
+        REQUIRE(latencyHistogramBucket(value) == value);
+        REQUIRE(latencyHistogramBucketUpperBound(value) == value);
+    }
+
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<unsigned> exponent(6, LATENCY_HISTOGRAM_MAX_EXPONENT - 1);
+
+    for (int i = 0; i < 10'000; ++i)
+    {
+        const unsigned e = exponent(rng);
+        const std::uint64_t value = (1ull << e) + (rng() & ((1ull << e) - 1));
+        const std::size_t bucket = latencyHistogramBucket(value);
+
+        REQUIRE(bucket < LATENCY_HISTOGRAM_BUCKETS);
+        REQUIRE(latencyHistogramBucketUpperBound(bucket) >= value);
+        REQUIRE(latencyHistogramBucketUpperBound(bucket) - value <= value / 32);
+        REQUIRE(latencyHistogramBucketUpperBound(bucket - 1) < value);
+    }
+
+    REQUIRE(latencyHistogramBucket(~0ull) == LATENCY_HISTOGRAM_BUCKETS - 1);
+    REQUIRE(latencyHistogramBucket((1ull << LATENCY_HISTOGRAM_MAX_EXPONENT) - 1) ==
+            LATENCY_HISTOGRAM_BUCKETS - 1);
+}
+
+TEST_CASE("LatencyDistribution reports percentiles within bucket precision", "[LatencyHistogram]")
+{
+    LatencyDistribution distribution;
+
+    REQUIRE(distribution.percentiles().p99_ns == 0);
+
+    // 1..10000 us, one sample each.
+    for (std::uint64_t us = 1; us <= 10'000; ++us)
+        distribution.record(us * 1000);
+
+    const auto p = distribution.percentiles();
+    const auto near = [](std::uint64_t actual, std::uint64_t expected)
+    { return actual >= expected && actual - expected <= expected / 32; };
+
+    REQUIRE(p.count == 10'000);
+    REQUIRE(near(p.p50_ns, 5'000'000));
+    REQUIRE(near(p.p90_ns, 9'000'000));
+    REQUIRE(near(p.p99_ns, 9'900'000));
+    REQUIRE(near(p.p999_ns, 9'990'000));
+    REQUIRE(p.max_ns == 10'000'000);
+    REQUIRE(distribution.valueAtPercentile(100.0) == 10'000'000);
+}
+
+TEST_CASE("LatencyDistribution subtract leaves the samples recorded since", "[LatencyHistogram]")
+{
+    LatencyHistogram histogram;
+
+    for (int i = 0; i < 1000; ++i)
+        histogram.record(100);
+
+    LatencyDistribution first;
+    histogram.mergeInto(first);
+
+    for (int i = 0; i < 10; ++i)
+        histogram.record(50'000);
+
+    LatencyDistribution second;
+    histogram.mergeInto(second);
+
+    LatencyDistribution window = second;
+    window.subtract(first);
+
+    REQUIRE(second.count() == 1010);
+    REQUIRE(window.count() == 10);
+    REQUIRE(window.percentiles().p50_ns == 50'000);
+    REQUIRE(window.max() == 50'000);
+
+    LatencyDistribution empty_window = second;
+    empty_window.subtract(second);
+    REQUIRE(empty_window.count() == 0);
+    REQUIRE(empty_window.percentiles().p99_ns == 0);
+}
+
+TEST_CASE("LatencyHistograms recorded per thread merge into one distribution",
+          "[LatencyHistogram]")
+{
+    constexpr int threads = 4;
+    constexpr std::uint64_t per_thread = 100'000;
+
+    std::vector<LatencyHistogram> histograms(threads);
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back(
+            [&histograms, t]
+            {
+                for (std::uint64_t i = 0; i < per_thread; ++i)
+                    histograms[t].record(1000 * (t + 1));
+            });
+    }
+
+    for (auto &worker : workers)
+        worker.join();
+
+    LatencyDistribution merged;
+    for (const auto &histogram : histograms)
+        histogram.mergeInto(merged);
+
+    const auto p = merged.percentiles();
+    REQUIRE(p.count == threads * per_thread);
+    REQUIRE(p.max_ns == 4000);
+    REQUIRE(p.p50_ns >= 2000);
+    REQUIRE(p.p50_ns <= 2000 + 2000 / 32);
+    REQUIRE(p.p99_ns >= 4000 - 4000 / 32);
+}
@@ -1,6 +1,12 @@
 #include <catch2/catch_all.hpp>
 #include "edgenetswitch/core/Logger.hpp"
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 TEST_CASE("Logger writes basic messages", "[logger]")
 {
@@ -38,4 +44,186 @@ TEST_CASE("Logger parses log level strings correctly", "[Logger]")
     REQUIRE(Logger::parseLevel("Warn") == LogLevel::Warning);
     REQUIRE(Logger::parseLevel("error") == LogLevel::Error);
     REQUIRE(Logger::parseLevel("unknown") == LogLevel::Info);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Logger drains lines from every thread before shutdown returns", "[Logger]")
+{
+    const std::string path = "logger_threads_test_output.log";
+    std::filesystem::remove(path);
+
+    Logger::init(LogLevel::Info, path);
+
+    constexpr int Threads = 4;
+    constexpr int LinesPerThread = 200;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < Threads; ++t)
+    {
+        threads.emplace_back(
+            [t]
+            {
+                for (int i = 0; i < LinesPerThread; ++i)
+                {
+                    Logger::info("thread-line t=" + std::to_string(t) + " i=" + std::to_string(i));
+                }
+            });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto dropped = Logger::droppedCount();
+    Logger::debug("filtered-out");
+    Logger::shutdown();
+
+    std::ifstream file(path);
+    std::size_t written = 0;
+    bool saw_filtered = false;
+    for (std::string line; std::getline(file, line);)
+    {
+        if (line.find("thread-line") != std::string::npos)
+            ++written;
+        if (line.find("filtered-out") != std::string::npos)
+            saw_filtered = true;
+    }
+
+    REQUIRE(written + dropped == Threads * LinesPerThread);
+    REQUIRE_FALSE(saw_filtered);
+}
+
+TEST_CASE("Logger counts lines dropped when a thread's ring is full", "[Logger]")
+{
+    const std::string path = "logger_drop_test_output.log";
+    std::filesystem::remove(path);
+
+    Logger::init(LogLevel::Info, path);
+
+    // Several rings' worth in one burst; whatever the writer cannot keep up with is dropped.
+    const std::size_t total = Logger::RingCapacity * 4;
+    for (std::size_t i = 0; i < total; ++i)
+    {
+        Logger::info("burst-line");
+    }
+
+    const auto dropped = Logger::droppedCount();
+    Logger::shutdown();
+
+    std::ifstream file(path);
+    std::size_t written = 0;
+    bool saw_drop_report = false;
+    for (std::string line; std::getline(file, line);)
+    {
+        if (line.find("burst-line") != std::string::npos)
+            ++written;
+        if (line.find("[LOGGER] dropped") != std::string::npos)
+            saw_drop_report = true;
+    }
+
+    REQUIRE(written + dropped == total);
+    REQUIRE(saw_drop_report == (dropped > 0));
+    REQUIRE(Logger::droppedCount() == 0);
+}
+
+TEST_CASE("Logger macros skip building messages for disabled levels", "[Logger]")
+{
+    int evaluations = 0;
+    const auto message = [&evaluations]
+    {
+        ++evaluations;
+        return std::string("lazy-line");
+    };
+
+    EDGENETSWITCH_LOG_INFO(message());
+    REQUIRE(evaluations == 0); // not initialized
+
+    const std::string path = "logger_lazy_test_output.log";
+    std::filesystem::remove(path);
+    Logger::init(LogLevel::Warning, path);
+
+    REQUIRE_FALSE(Logger::enabled(LogLevel::Info));
+    REQUIRE(Logger::enabled(LogLevel::Error));
+
+    EDGENETSWITCH_LOG_DEBUG(message());
+    EDGENETSWITCH_LOG_INFO(message());
+    REQUIRE(evaluations == 0);
+
+    EDGENETSWITCH_LOG_WARN(message());
+    EDGENETSWITCH_LOG_ERROR(message());
+    REQUIRE(evaluations == 2);
+
+    Logger::shutdown();
+    REQUIRE_FALSE(Logger::enabled(LogLevel::Error));
+}
+
+TEST_CASE("LogRateLimiter allows a burst then refills at its rate", "[Logger]")
+{
+    LogRateLimiter limiter("test.bucket", 5);
+
+    int allowed = 0;
+    for (int i = 0; i < 20; ++i)
+    {
+        if (limiter.allow())
+            ++allowed;
+    }
+
+    REQUIRE(allowed == 5);
+    REQUIRE(limiter.emitted() == 5);
+    REQUIRE(limiter.suppressed() == 15);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    REQUIRE(limiter.allow());
+}
+
+TEST_CASE("LogRateLimiter samples one in N calls", "[Logger]")
+{
+    LogRateLimiter limiter("test.sample", 1000, 4);
+
+    int allowed = 0;
+    for (int i = 0; i < 40; ++i)
+    {
+        if (limiter.allow())
+            ++allowed;
+    }
+
+    REQUIRE(allowed == 10);
+    REQUIRE(limiter.suppressed() == 30);
+}
+
+TEST_CASE("Logger reports suppressed lines once per site", "[Logger]")
+{
+    const std::string path = "logger_limited_test_output.log";
+    std::filesystem::remove(path);
+    Logger::init(LogLevel::Info, path);
+
+    for (int i = 0; i < 50; ++i)
+    {
+        EDGENETSWITCH_LOG_WARN_LIMITED("test.flood", 2, 1, "flood-line");
+    }
+
+    const auto sites = Logger::rateLimitedSites();
+    const auto site = std::find_if(sites.begin(), sites.end(),
+                                   [](const LogSiteStats &s) { return s.name == "test.flood"; });
+    REQUIRE(site != sites.end());
+    REQUIRE(site->emitted == 2);
+    REQUIRE(site->suppressed == 48);
+
+    Logger::reportSuppressed();
+    Logger::reportSuppressed(); // nothing new to report
+    Logger::shutdown();
+
+    std::ifstream file(path);
+    std::size_t flood_lines = 0;
+    std::size_t reports = 0;
+    for (std::string line; std::getline(file, line);)
+    {
+        if (line.find("flood-line") != std::string::npos)
+            ++flood_lines;
+        if (line.find("suppressed 48 lines at test.flood") != std::string::npos)
+            ++reports;
+    }
+
+    REQUIRE(flood_lines == 2);
+    REQUIRE(reports == 1);
+}
@@ -0,0 +1,79 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "edgenetswitch/switching/MacAddress.hpp"
+#include "edgenetswitch/switching/MacTable.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace edgenetswitch;
+
+// Not registered with ctest; run `MacTableBenchmarks "[!benchmark]"` for ns/op per table size.
+namespace
+{
+    constexpr std::size_t kLookupKeys = 4096; // power of two, indexed with a mask
+
+    std::vector<MacAddress> randomMacs(std::size_t count, std::uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::vector<MacAddress> macs;
+        macs.reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            macs.push_back(MacAddress::fromPacked(rng() & 0xFFFFFFFFFFFFull));
+        }
+
+        return macs;
+    }
+
+    void benchmarkLookups(std::size_t entries)
+    {
+        MacTable table(entries);
+        const auto learned = randomMacs(entries, entries);
+
+        for (std::size_t i = 0; i < learned.size(); ++i)
+        {
+            table.learn(learned[i], static_cast<std::uint32_t>(i % 8), i);
+        }
+
+        std::vector<MacAddress> hits;
+        hits.reserve(kLookupKeys);
+        std::mt19937_64 rng(7);
+        for (std::size_t i = 0; i < kLookupKeys; ++i)
+        {
+            hits.push_back(learned[rng() % learned.size()]);
+        }
+
+        const auto misses = randomMacs(kLookupKeys, entries + 1);
+        const std::string label = std::to_string(entries) + " entries";
+
+        std::size_t next = 0;
+        BENCHMARK("lookup hit, " + label)
+        {
+            return table.lookup(hits[next++ & (kLookupKeys - 1)]);
+        };
+
+        BENCHMARK("lookup miss, " + label)
+        {
+            return table.lookup(misses[next++ & (kLookupKeys - 1)]);
+        };
+
+        BENCHMARK("learn refresh, " + label)
+        {
+            const auto &mac = hits[next & (kLookupKeys - 1)];
+            table.learn(mac, 1, entries + next++);
+        };
+    }
+} // namespace
+
+TEST_CASE("MacTable lookup cost by table size", "[MacTable][!benchmark]")
+{
+    benchmarkLookups(1024);
+    benchmarkLookups(64 * 1024);
+    benchmarkLookups(1024 * 1024);
+}
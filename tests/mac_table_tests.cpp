@@ -3,8 +3,14 @@
 #include "edgenetswitch/switching/MacAddress.hpp"
 #include "edgenetswitch/switching/MacTable.hpp"
 
+#include <atomic>
+#include <cstdint>
+#include <map>
 #include <optional>
+#include <random>
 #include <string_view>
+#include <thread>
+#include <utility>
 
 using namespace edgenetswitch;
 
@@ -75,3 +81,270 @@ TEST_CASE("MacTable ageOut preserves entries newer than max age", "[MacTable]")
     REQUIRE(table.lookup(fresh) == 5);
     REQUIRE(table.size() == 1);
 }
+
+TEST_CASE("MacAddress packs into a 48-bit key and back", "[MacTable]")
+{
+    const MacAddress address = mac("01:23:45:67:89:AB");
+
+    REQUIRE(address.packed() == 0x0123456789ABull);
+    REQUIRE(MacAddress::fromPacked(address.packed()) == address);
+    REQUIRE(mac("00:00:00:00:00:01").packed() < mac("00:00:00:00:01:00").packed());
+}
+
+TEST_CASE("MacTable evicts the least recently seen entry when full", "[MacTable]")
+{
+    MacTable table(2);
+    const MacAddress first = mac("00:11:22:33:44:01");
+    const MacAddress second = mac("00:11:22:33:44:02");
+    const MacAddress third = mac("00:11:22:33:44:03");
+
+    table.learn(first, 1, 10);
+    table.learn(second, 2, 20);
+    table.learn(first, 3, 30);
+    table.learn(third, 4, 40);
+
+    REQUIRE(table.size() == 2);
+    REQUIRE(table.lookup(first) == 3);
+    REQUIRE(table.lookup(second) == std::nullopt);
+    REQUIRE(table.lookup(third) == 4);
+}
+
+TEST_CASE("MacTable snapshot is ordered by MAC address", "[MacTable]")
+{
+    MacTable table(8);
+
+    table.learn(mac("00:00:00:00:00:03"), 3, 1);
+    table.learn(mac("00:00:00:00:00:01"), 1, 1);
+    table.learn(mac("00:00:00:00:00:02"), 2, 1);
+
+    const auto entries = table.snapshot();
+
+    REQUIRE(entries.size() == 3);
+    REQUIRE(entries[0].mac == mac("00:00:00:00:00:01"));
+    REQUIRE(entries[1].mac == mac("00:00:00:00:00:02"));
+    REQUIRE(entries[2].mac == mac("00:00:00:00:00:03"));
+}
+
+TEST_CASE("MacTable matches a reference map under learn and age churn", "[MacTable]")
+{
+    constexpr std::size_t capacity = 512;
+    MacTable table(capacity);
+    std::map<std::uint64_t, std::pair<std::uint32_t, std::uint64_t>> reference;
+    std::mt19937_64 rng(0xED6E);
+
+    for (std::uint64_t tick = 1; tick <= 4000; ++tick)
+    {
+        // Shared vendor prefix with a small address space forces long, overlapping probe chains.
+        const std::uint64_t packed = 0x001122000000ull | (rng() % 1024);
+        const auto port = static_cast<std::uint32_t>(rng() % 8);
+
+        if (reference.find(packed) == reference.end() && reference.size() >= capacity)
+        {
+            auto oldest = reference.begin();
+            for (auto it = reference.begin(); it != reference.end(); ++it)
+            {
+                if (it->second.second < oldest->second.second)
+                    oldest = it;
+            }
+            reference.erase(oldest);
+        }
+
+        table.learn(MacAddress::fromPacked(packed), port, tick);
+        reference[packed] = {port, tick};
+
+        if (tick % 500 == 0)
+        {
+            table.ageOut(tick, 300);
+            std::erase_if(reference, [&](const auto &item)
+                          { return (tick - item.second.second) > 300; });
+        }
+
+        REQUIRE(table.size() == reference.size());
+    }
+
+    for (std::uint64_t packed = 0x001122000000ull; packed < 0x001122000400ull; ++packed)
+    {
+        const auto it = reference.find(packed);
+        const auto found = table.lookup(MacAddress::fromPacked(packed));
+
+        if (it == reference.end())
+            REQUIRE(found == std::nullopt);
+        else
+            REQUIRE(found == it->second.first);
+    }
+}
+
+TEST_CASE("MacTable counts evictions during a MAC flood", "[MacTable]")
+{
+    constexpr std::size_t capacity = 64;
+    constexpr std::uint64_t flood = 1000;
+    MacTable table(capacity);
+
+    for (std::uint64_t i = 0; i < flood; ++i)
+    {
+        table.learn(MacAddress::fromPacked(0x020000000000ull + i), 1, i);
+    }
+
+    REQUIRE(table.size() == capacity);
+    REQUIRE(table.evictions() == flood - capacity);
+
+    // The most recent `capacity` sources survive; everything older was evicted in order.
+    REQUIRE(table.lookup(MacAddress::fromPacked(0x020000000000ull + flood - capacity)) == 1);
+    REQUIRE(table.lookup(MacAddress::fromPacked(0x020000000000ull + flood - capacity - 1)) ==
+            std::nullopt);
+
+    table.ageOut(flood, 0);
+    REQUIRE(table.size() == 0);
+    REQUIRE(table.evictions() == flood - capacity);
+}
+
+TEST_CASE("MacTable aging matches a full sweep across wall-clock ticks", "[MacTable]")
+{
+    // Larger than the 400-address key space, so only aging ever removes entries.
+    constexpr std::size_t capacity = 512;
+    constexpr std::uint64_t max_age = 300;
+    MacTable table(capacity);
+    std::map<std::uint64_t, std::pair<std::uint32_t, std::uint64_t>> reference;
+    std::mt19937_64 rng(0xA6E);
+
+    // Epoch-millisecond ticks exercise the upper wheel levels and cascading.
+    std::uint64_t now = 1'700'000'000'000ull;
+
+    for (int step = 0; step < 5000; ++step)
+    {
+        now += rng() % 40;
+
+        const std::uint64_t packed = 0x0A0000000000ull | (rng() % 400);
+        // Occasionally learn with a tick behind the clock to hit the overdue path.
+        const std::uint64_t tick = (rng() % 16 == 0) ? now - (rng() % (2 * max_age)) : now;
+
+        table.learn(MacAddress::fromPacked(packed), 1, tick);
+        reference[packed] = {1, tick};
+
+        if (step % 7 == 0)
+        {
+            table.ageOut(now, max_age);
+            std::erase_if(reference, [&](const auto &item)
+                          { return (now - item.second.second) > max_age; });
+        }
+
+        REQUIRE(table.size() == reference.size());
+    }
+
+    table.ageOut(now + 10'000, max_age);
+    REQUIRE(table.size() == 0);
+    REQUIRE(table.snapshot().empty());
+}
+
+TEST_CASE("MacTable refresh moves an entry to its new aging bucket", "[MacTable]")
+{
+    MacTable table(4);
+    const MacAddress address = mac("00:11:22:33:44:0A");
+
+    table.learn(address, 1, 100);
+    table.learn(address, 2, 1'000);
+
+    table.ageOut(1'000, 50);
+    REQUIRE(table.lookup(address) == 2);
+
+    table.ageOut(1'051, 50);
+    REQUIRE(table.lookup(address) == std::nullopt);
+}
+
+TEST_CASE("MacTable ageOut honours the expiration budget across calls", "[MacTable]")
+{
+    MacTable table(64);
+
+    for (std::uint64_t i = 0; i < 40; ++i)
+    {
+        table.learn(MacAddress::fromPacked(0x001122330000ull + i), 1, 10 + i % 2);
+    }
+    table.learn(mac("00:11:22:33:FF:FF"), 2, 950);
+
+    REQUIRE(table.ageOut(1'000, 100, 16) == 16);
+    REQUIRE(table.size() == 25);
+
+    REQUIRE(table.ageOut(1'000, 100, 16) == 16);
+    REQUIRE(table.ageOut(1'000, 100, 16) == 8);
+    REQUIRE(table.ageOut(1'000, 100, 16) == 0);
+    REQUIRE(table.size() == 1);
+    REQUIRE(table.lookup(mac("00:11:22:33:FF:FF")) == 2);
+}
+
+TEST_CASE("MacTable readers stay consistent while the writer learns and ages", "[MacTable]")
+{
+    // Stable entries are refreshed every round and never age out; churn entries share their
+    // probe chains and are aged away behind them, so backward shifts keep relocating both.
+    constexpr std::uint64_t stable_count = 64;
+    constexpr std::uint64_t churn_count = 192;
+    constexpr std::uint64_t rounds = 300;
+    MacTable table(512);
+
+    const auto stable_mac = [](std::uint64_t i)
+    { return MacAddress::fromPacked(0x001122000000ull + i); };
+    const auto stable_port = [](std::uint64_t i) { return static_cast<std::uint32_t>(i % 8); };
+
+    for (std::uint64_t i = 0; i < stable_count; ++i)
+    {
+        table.learn(stable_mac(i), stable_port(i), 0);
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<std::uint64_t> lookup_mismatches{0};
+    std::atomic<std::uint64_t> snapshot_errors{0};
+
+    std::thread reader(
+        [&]
+        {
+            std::uint64_t i = 0;
+            while (!done.load(std::memory_order_acquire))
+            {
+                const std::uint64_t index = i++ % stable_count;
+                if (table.lookup(stable_mac(index)) != stable_port(index))
+                    lookup_mismatches.fetch_add(1, std::memory_order_relaxed);
+
+                if (i % 64 == 0)
+                {
+                    const auto entries = table.snapshot();
+                    for (std::size_t e = 1; e < entries.size(); ++e)
+                    {
+                        if (!(entries[e - 1].mac < entries[e].mac))
+                            snapshot_errors.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+
+                std::this_thread::yield();
+            }
+        });
+
+    for (std::uint64_t round = 1; round <= rounds; ++round)
+    {
+        for (std::uint64_t j = 0; j < churn_count; ++j)
+        {
+            const std::uint64_t packed =
+                0x001122000000ull + stable_count + (round * 31 + j) % 1024;
+            table.learn(MacAddress::fromPacked(packed), 100, round);
+        }
+
+        for (std::uint64_t i = 0; i < stable_count; ++i)
+        {
+            table.learn(stable_mac(i), stable_port(i), round);
+        }
+
+        table.ageOut(round, 1);
+
+        if (round % 16 == 0)
+            std::this_thread::yield();
+    }
+
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    REQUIRE(lookup_mismatches.load() == 0);
+    REQUIRE(snapshot_errors.load() == 0);
+
+    for (std::uint64_t i = 0; i < stable_count; ++i)
+    {
+        REQUIRE(table.lookup(stable_mac(i)) == stable_port(i));
+    }
+}
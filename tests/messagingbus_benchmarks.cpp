@@ -0,0 +1,44 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "edgenetswitch/messaging/MessagingBus.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+using namespace edgenetswitch;
+
+// Not registered with ctest; run `MessagingBusBenchmarks "[!benchmark]"` for ns/publish.
+namespace
+{
+    void benchmarkPublish(std::size_t subscribers)
+    {
+        MessagingBus bus;
+        std::uint64_t delivered = 0;
+
+        for (std::size_t i = 0; i < subscribers; ++i)
+        {
+            bus.subscribe(MessageType::PacketProcessed,
+                          [&delivered](const Message &)
+                          {
+                              ++delivered;
+                          });
+        }
+
+        const Message message{MessageType::PacketProcessed, 0};
+
+        BENCHMARK("publish, " + std::to_string(subscribers) + " subscribers")
+        {
+            bus.publish(message);
+            return delivered;
+        };
+    }
+} // namespace
+
+TEST_CASE("MessagingBus publish cost", "[!benchmark][MessagingBus]")
+{
+    benchmarkPublish(0);
+    benchmarkPublish(1);
+    benchmarkPublish(8);
+}
@@ -2,6 +2,10 @@
 
 #include "edgenetswitch/messaging/MessagingBus.hpp"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 using namespace edgenetswitch;
 
 TEST_CASE("Single subscriber receives published message", "[MessagingBus]")
@@ -68,4 +72,76 @@ TEST_CASE("Subscribers only receive messages of the subscribed type", "[Messagin
 
     REQUIRE(systemStartReceived == true);
     REQUIRE(healthStatusReceived == false);
-}
\ No newline at end of file
+}
+TEST_CASE("Subscribing from a callback takes effect on the next publish", "[MessagingBus]")
+{
+    MessagingBus bus;
+
+    int lateCalls = 0;
+    bool subscribed = false;
+
+    bus.subscribe(MessageType::SystemStart,
+                  [&](const Message &)
+                  {
+                      if (!subscribed)
+                      {
+                          subscribed = true;
+                          bus.subscribe(MessageType::SystemStart,
+                                        [&](const Message &)
+                                        {
+                                            lateCalls++;
+                                        });
+                      }
+                  });
+
+    bus.publish({MessageType::SystemStart});
+    REQUIRE(lateCalls == 0);
+
+    bus.publish({MessageType::SystemStart});
+    REQUIRE(lateCalls == 1);
+}
+
+TEST_CASE("Sinks run after observers and the last sink owns an rvalue message", "[MessagingBus]")
+{
+    MessagingBus bus;
+
+    std::vector<std::string> order;
+    std::string copied;
+    std::string owned;
+
+    bus.subscribeSink(MessageType::PacketRx,
+                      [&](Message &&msg)
+                      {
+                          order.push_back("sink1");
+                          copied = std::move(std::get<Packet>(msg.payload).payload);
+                      });
+
+    bus.subscribeSink(MessageType::PacketRx,
+                      [&](Message &&msg)
+                      {
+                          order.push_back("sink2");
+                          owned = std::move(std::get<Packet>(msg.payload).payload);
+                      });
+
+    bus.subscribe(MessageType::PacketRx,
+                  [&](const Message &msg)
+                  {
+                      order.push_back("observer");
+                      REQUIRE(std::get<Packet>(msg.payload).payload == "data");
+                  });
+
+    Packet packet;
+    packet.payload = "data";
+
+    Message message{MessageType::PacketRx, 0, packet};
+    bus.publish(std::move(message));
+
+    REQUIRE(order == std::vector<std::string>{"observer", "sink1", "sink2"});
+    REQUIRE(copied == "data");
+    REQUIRE(owned == "data");
+
+    Message kept{MessageType::PacketRx, 0, packet};
+    bus.publish(kept);
+
+    REQUIRE(std::get<Packet>(kept.payload).payload == "data");
+}
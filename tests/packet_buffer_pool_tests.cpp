@@ -0,0 +1,114 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "edgenetswitch/packet/Packet.hpp"
+#include "edgenetswitch/packet/PacketBufferPool.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+using namespace edgenetswitch;
+
+TEST_CASE("PacketBufferPool rejects an empty configuration", "[PacketBufferPool]")
+{
+    REQUIRE_THROWS_AS(PacketBufferPool(0, 1), std::invalid_argument);
+    REQUIRE_THROWS_AS(PacketBufferPool(4, 0), std::invalid_argument);
+}
+
+TEST_CASE("PacketBufferPool hands out slabs until the shard is exhausted", "[PacketBufferPool]")
+{
+    PacketBufferPool pool(2, 2);
+    REQUIRE(pool.capacity() == 4);
+
+    PacketBuffer a = pool.acquire(0);
+    PacketBuffer b = pool.acquire(0);
+    REQUIRE(a.valid());
+    REQUIRE(b.valid());
+    REQUIRE(a.data() != b.data());
+    REQUIRE(a.capacity() == PacketBufferPool::SlabSize);
+    REQUIRE(pool.inUse() == 2);
+
+    // Shard 0 is empty, shard 1 still has its own slabs.
+    REQUIRE_FALSE(pool.acquire(0).valid());
+    REQUIRE(pool.acquire(1).valid());
+    REQUIRE_FALSE(pool.acquire(2).valid());
+
+    a.reset();
+    REQUIRE(pool.inUse() == 1);
+    REQUIRE(pool.acquire(0).valid());
+}
+
+TEST_CASE("PacketBuffer copies share the slab until the last one is released",
+          "[PacketBufferPool]")
+{
+    PacketBufferPool pool(1);
+
+    PacketBuffer original = pool.acquire(0);
+    PacketBuffer copy = original;
+    REQUIRE(copy.data() == original.data());
+
+    original.reset();
+    REQUIRE(pool.inUse() == 1);
+    REQUIRE_FALSE(pool.acquire(0).valid());
+
+    PacketBuffer moved = std::move(copy);
+    REQUIRE_FALSE(copy.valid());
+    REQUIRE(pool.inUse() == 1);
+
+    moved.reset();
+    REQUIRE(pool.inUse() == 0);
+    REQUIRE(pool.acquire(0).valid());
+}
+
+TEST_CASE("Pooled packet payloads view the slab and detach into owned storage",
+          "[PacketBufferPool]")
+{
+    PacketBufferPool pool(1);
+
+    PacketBuffer slab = pool.acquire(0);
+    std::memcpy(slab.data(), "id=1;payload=hello", 18);
+
+    Packet packet;
+    packet.payload = PacketPayload(std::move(slab), 13, 5);
+
+    REQUIRE(packet.payload.pooled());
+    REQUIRE(packet.payload == "hello");
+
+    Packet copy = packet;
+    REQUIRE(copy.payload.data() == packet.payload.data());
+
+    copy.payload.detach();
+    REQUIRE_FALSE(copy.payload.pooled());
+    REQUIRE(copy.payload == "hello");
+
+    packet = Packet{};
+    REQUIRE(pool.inUse() == 0);
+    REQUIRE(copy.payload == "hello");
+}
+
+TEST_CASE("PacketBufferPool recycles slabs released from other threads", "[PacketBufferPool]")
+{
+    constexpr int Rounds = 10000;
+    PacketBufferPool pool(8);
+
+    int acquired = 0;
+
+    for (int round = 0; round < Rounds; ++round)
+    {
+        PacketBuffer buffer = pool.acquire(0);
+
+        while (!buffer.valid())
+        {
+            std::this_thread::yield();
+            buffer = pool.acquire(0);
+        }
+
+        ++acquired;
+        std::thread releaser([b = std::move(buffer)]() mutable { b.reset(); });
+        releaser.join();
+    }
+
+    REQUIRE(acquired == Rounds);
+    REQUIRE(pool.inUse() == 0);
+}
@@ -18,6 +18,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -73,9 +74,9 @@ namespace
         packet.payload_size = static_cast<std::uint32_t>(packet.payload.size());
         packet.wire_size = packet.payload_size + 14;
         packet.valid = true;
-        packet.source_mac = source;
-        packet.destination_mac = destination;
-        packet.ingress_port = ingress_port;
+        packet.setSourceMac(source);
+        packet.setDestinationMac(destination);
+        packet.setIngressPort(ingress_port);
         return packet;
     }
 
@@ -320,7 +321,7 @@ TEST_CASE("PacketProcessor publishes flood decision for broadcast destination",
     REQUIRE(events.forwarding_events.front().lifecycle_id == packet.lifecycle_id);
     REQUIRE(events.forwarding_events.front().action == ForwardingAction::Flood);
     REQUIRE(events.forwarding_events.front().egress_ports ==
-            std::vector<std::uint32_t>{1, 3, 4});
+            PortSet{1, 3, 4});
     REQUIRE(events.processed_packets.size() == 1);
     REQUIRE(events.order == std::vector<MessageType>{MessageType::ForwardingDecisionMade,
                                                      MessageType::PacketProcessed});
@@ -345,7 +346,7 @@ TEST_CASE("PacketProcessor publishes forward decision for known unicast destinat
     REQUIRE(events.forwarding_events.size() == 1);
     REQUIRE(events.forwarding_events.front().lifecycle_id == packet.lifecycle_id);
     REQUIRE(events.forwarding_events.front().action == ForwardingAction::ForwardToPorts);
-    REQUIRE(events.forwarding_events.front().egress_ports == std::vector<std::uint32_t>{4});
+    REQUIRE(events.forwarding_events.front().egress_ports == PortSet{4});
     REQUIRE(events.processed_packets.size() == 1);
     REQUIRE(events.order == std::vector<MessageType>{MessageType::ForwardingDecisionMade,
                                                      MessageType::PacketProcessed});
@@ -395,7 +396,7 @@ TEST_CASE("PacketProcessor dispatches known unicast to TransportManager backend"
 
     REQUIRE(events.forwarding_events.size() == 1);
     REQUIRE(events.forwarding_events.front().action == ForwardingAction::ForwardToPorts);
-    REQUIRE(events.forwarding_events.front().egress_ports == std::vector<std::uint32_t>{4});
+    REQUIRE(events.forwarding_events.front().egress_ports == PortSet{4});
     REQUIRE(backend.transmit_count == 1);
     REQUIRE(backend.last_packet_id == packet.id);
     REQUIRE(backend.last_lifecycle_id == packet.lifecycle_id);
@@ -421,7 +422,7 @@ TEST_CASE("PacketProcessor dispatches flood decision once per egress port",
     REQUIRE(events.forwarding_events.size() == 1);
     REQUIRE(events.forwarding_events.front().action == ForwardingAction::Flood);
     REQUIRE(events.forwarding_events.front().egress_ports ==
-            std::vector<std::uint32_t>{1, 3, 4});
+            PortSet{1, 3, 4});
     REQUIRE(port1.transmit_count == 1);
     REQUIRE(port3.transmit_count == 1);
     REQUIRE(port4.transmit_count == 1);
@@ -559,3 +560,37 @@ TEST_CASE("TransportManager resetCounters clears accumulated counters",
 
     requireCountersZero(transport_manager.counters());
 }
+
+TEST_CASE("TransportManager counters can be read while another thread transmits",
+          "[PacketForwardingRuntime][Transport]")
+{
+    transport::TransportManager transport_manager;
+    registerBackend(transport_manager, 4, transport::TransmitStatus::Success);
+    const Packet packet = makePacket(16,
+                                     mac("00:11:22:33:44:01"),
+                                     mac("00:11:22:33:44:02"),
+                                     2);
+    constexpr std::uint64_t transmits = 20'000;
+
+    std::thread worker(
+        [&]
+        {
+            for (std::uint64_t i = 0; i < transmits; ++i)
+                transport_manager.transmit(4, packet);
+        });
+
+    std::uint64_t last_seen = 0;
+    bool monotonic = true;
+    while (last_seen < transmits)
+    {
+        const auto seen = transport_manager.counters().tx_packets;
+        monotonic = monotonic && seen >= last_seen;
+        last_seen = seen;
+    }
+
+    worker.join();
+
+    REQUIRE(monotonic);
+    requireCounters(transport_manager.counters(),
+                    {.tx_packets = transmits, .tx_bytes = transmits * packet.payload.size()});
+}
@@ -0,0 +1,50 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "edgenetswitch/packet/PacketParser.hpp"
+
+#include <string>
+
+using namespace edgenetswitch;
+
+// Not registered with ctest; run `PacketParserBenchmarks "[!benchmark]"` for ns/parse.
+TEST_CASE("Packet parser throughput", "[!benchmark][PacketParser]")
+{
+    const std::string valid = "id=123456789;payload=hello-edge-switch";
+    const std::string malformed = "id=not-a-number;payload=hello-edge-switch";
+    // Largest datagram the UDP receiver accepts.
+    const std::string maximum = "id=18446744073709551615;payload=" + std::string(1024 - 32, 'x');
+
+    Packet binaryPacket;
+    binaryPacket.id = 123456789;
+    binaryPacket.payload = "hello-edge-switch";
+    binaryPacket.setSourceMac(MacAddress::fromPacked(0x020000000001));
+    binaryPacket.setDestinationMac(MacAddress::fromPacked(0x020000000002));
+    binaryPacket.setIngressPort(1);
+    const std::string binary = encodeBinaryPacket(binaryPacket);
+
+    BENCHMARK("parsePacketFields, valid")
+    {
+        return parsePacketFields(valid);
+    };
+
+    BENCHMARK("parsePacketFields, valid binary")
+    {
+        return parsePacketFields(binary);
+    };
+
+    BENCHMARK("parsePacketFields, malformed")
+    {
+        return parsePacketFields(malformed);
+    };
+
+    BENCHMARK("parsePacketFields, maximum size")
+    {
+        return parsePacketFields(maximum);
+    };
+
+    BENCHMARK("parsePacket, valid (owned payload)")
+    {
+        return parsePacket(valid);
+    };
+}
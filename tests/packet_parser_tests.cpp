@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstring>
 #include <limits>
+#include <stdexcept>
 #include <string>
 
 #include "edgenetswitch/packet/PacketParser.hpp"
@@ -131,3 +133,113 @@ TEST_CASE("parsePacket handles duplicate id fields without crashing", "[PacketPa
     const std::string input = "id=1;id=2;payload=x";
     REQUIRE_NOTHROW(parsePacket(input));
 }
+
+TEST_CASE("parsePacket binds the payload to a pooled buffer without copying", "[PacketParser]")
+{
+    PacketBufferPool pool(1);
+    PacketBuffer buffer = pool.acquire(0);
+
+    const std::string input = "id=9;payload=pooled;";
+    std::memcpy(buffer.data(), input.data(), input.size());
+    const char *slab = buffer.data();
+
+    Packet packet = parsePacket(std::move(buffer), input.size());
+    REQUIRE(packet.valid);
+    REQUIRE(packet.id == 9);
+    REQUIRE(packet.payload.pooled());
+    REQUIRE(packet.payload == "pooled");
+    REQUIRE(packet.payload.data() == slab + 13);
+    REQUIRE(packet.payload_size == 6);
+
+    packet = Packet{};
+    REQUIRE(pool.inUse() == 0);
+}
+
+TEST_CASE("parsePacketFields reports a typed error for each malformed input", "[PacketParser]")
+{
+    REQUIRE(parsePacketFields("").error == PacketParseError::EmptyInput);
+    REQUIRE(parsePacketFields("payload=hello").error == PacketParseError::MissingId);
+    REQUIRE(parsePacketFields("id=;payload=x").error == PacketParseError::EmptyId);
+    REQUIRE(parsePacketFields("id=abc;payload=x").error == PacketParseError::InvalidId);
+    REQUIRE(parsePacketFields("id=-1;payload=x").error == PacketParseError::InvalidId);
+    REQUIRE(parsePacketFields("id=18446744073709551616").error == PacketParseError::IdOutOfRange);
+}
+
+TEST_CASE("parsePacketFields views the payload inside the input", "[PacketParser]")
+{
+    const std::string input = "id=3;payload=view;extra=1";
+    const auto result = parsePacketFields(input);
+
+    REQUIRE(result.ok());
+    REQUIRE(result.id == 3);
+    REQUIRE(result.payload == "view");
+    REQUIRE(result.payload.data() == input.data() + result.payload_offset);
+}
+
+TEST_CASE("encodeBinaryPacket round-trips through parsePacket", "[PacketParser]")
+{
+    Packet original;
+    original.id = std::numeric_limits<std::uint64_t>::max();
+    original.payload = "binary";
+    original.setSourceMac(MacAddress::fromPacked(0x0A0B0C0D0E0F));
+    original.setDestinationMac(MacAddress::fromPacked(0xFFFFFFFFFFFF));
+    original.setIngressPort(7);
+
+    const std::string wire = encodeBinaryPacket(original);
+    REQUIRE(wire.size() == BINARY_PACKET_HEADER_SIZE + 6);
+
+    const Packet packet = parsePacket(wire);
+    REQUIRE(packet.valid);
+    REQUIRE(packet.id == original.id);
+    REQUIRE(packet.payload == "binary");
+    REQUIRE(packet.payload_size == 6);
+    REQUIRE(packet.sourceMac() == original.sourceMac());
+    REQUIRE(packet.destinationMac() == original.destinationMac());
+    REQUIRE(packet.ingressPort() == 7u);
+    REQUIRE(packet.wireFormat() == PacketWireFormat::Binary);
+    REQUIRE(parsePacket("id=1;payload=text").wireFormat() == PacketWireFormat::Text);
+}
+
+TEST_CASE("Binary packets leave unflagged header fields unset", "[PacketParser]")
+{
+    Packet original;
+    original.id = 12;
+    original.setDestinationMac(MacAddress::fromPacked(0x020000000002));
+
+    const auto result = parsePacketFields(encodeBinaryPacket(original));
+    REQUIRE(result.ok());
+    REQUIRE(result.id == 12);
+    REQUIRE(result.payload.empty());
+    REQUIRE_FALSE(result.source_mac.has_value());
+    REQUIRE(result.destination_mac == original.destinationMac());
+    REQUIRE_FALSE(result.ingress_port.has_value());
+}
+
+TEST_CASE("Binary packets are bounds-checked against the header and length", "[PacketParser]")
+{
+    Packet original;
+    original.id = 1;
+    original.payload = "abc";
+    const std::string wire = encodeBinaryPacket(original);
+
+    for (std::size_t size = 1; size < BINARY_PACKET_HEADER_SIZE; ++size)
+    {
+        REQUIRE(parsePacketFields(std::string_view(wire).substr(0, size)).error ==
+                PacketParseError::TruncatedHeader);
+    }
+
+    REQUIRE(parsePacketFields(wire.substr(0, wire.size() - 1)).error ==
+            PacketParseError::PayloadLengthMismatch);
+    REQUIRE(parsePacketFields(wire + "x").error == PacketParseError::PayloadLengthMismatch);
+
+    std::string future = wire;
+    future[1] = static_cast<char>(BINARY_PACKET_VERSION + 1);
+    REQUIRE(parsePacketFields(future).error == PacketParseError::UnsupportedVersion);
+}
+
+TEST_CASE("encodeBinaryPacket rejects payloads beyond the length field", "[PacketParser]")
+{
+    Packet packet;
+    packet.payload = std::string(0x10000, 'x');
+    REQUIRE_THROWS_AS(encodeBinaryPacket(packet), std::length_error);
+}
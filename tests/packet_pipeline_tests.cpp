@@ -1,11 +1,18 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include "edgenetswitch/core/TimeUtils.hpp"
 #include "edgenetswitch/messaging/MessagingBus.hpp"
+#include "edgenetswitch/packet/LifecycleIdGenerator.hpp"
 #include "edgenetswitch/packet/PacketProcessor.hpp"
 #include "edgenetswitch/packet/PacketStats.hpp"
 
 #include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
 #include <thread>
+#include <vector>
 #include <unistd.h>
 
 using namespace edgenetswitch;
@@ -31,7 +38,7 @@ namespace
     std::uint64_t dropsTotal(const PacketMetrics &metrics)
     {
         std::uint64_t total = 0;
-        for (const auto &[_, count] : metrics.drops_by_reason)
+        for (const auto count : metrics.drops_by_reason)
         {
             total += count;
         }
@@ -39,6 +46,17 @@ namespace
         return total;
     }
 
+    std::uint64_t dropsFor(const PacketMetrics &metrics, PacketDropReason reason)
+    {
+        return metrics.drops_by_reason[dropReasonIndex(reason)];
+    }
+
+    std::uint64_t dropsFor(const PacketMetrics &metrics, PacketDropSource source,
+                           PacketDropReason reason)
+    {
+        return metrics.drops_by_source[dropSourceIndex(source)][dropReasonIndex(reason)];
+    }
+
     struct PacketPipelineFixture
     {
         MessagingBus bus;
@@ -290,11 +308,8 @@ TEST_CASE("Packet lifecycle accounting remains consistent for validation drops",
         [&]
         {
             metrics = stats.snapshotAt(now_ms + packet_count);
-            const auto validation_it =
-                metrics.drops_by_reason.find(PacketDropReason::ValidationError);
             return metrics.ingress_packets == packet_count &&
-                   validation_it != metrics.drops_by_reason.end() &&
-                   validation_it->second == packet_count;
+                   dropsFor(metrics, PacketDropReason::ValidationError) == packet_count;
         }));
 
     REQUIRE(waitUntil(
@@ -360,9 +375,8 @@ TEST_CASE("Packet lifecycle accounting remains consistent under real overload",
         [&]
         {
             auto m = stats.snapshotAt(now_ms + packet_count);
-            const auto overflow_it = m.drops_by_reason.find(PacketDropReason::QueueOverflow);
-            return m.ingress_packets >= overload_count && overflow_it != m.drops_by_reason.end() &&
-                   overflow_it->second > 0;
+            return m.ingress_packets >= overload_count &&
+                   dropsFor(m, PacketDropReason::QueueOverflow) > 0;
         }));
 
     REQUIRE(waitUntil(
@@ -374,10 +388,11 @@ TEST_CASE("Packet lifecycle accounting remains consistent under real overload",
 
     auto m = stats.snapshotAt(now_ms + packet_count);
     const std::uint64_t drops_total = dropsTotal(m);
-    const auto overflow_it = m.drops_by_reason.find(PacketDropReason::QueueOverflow);
+    const std::uint64_t overflow_drops = dropsFor(m, PacketDropReason::QueueOverflow);
 
-    REQUIRE(overflow_it != m.drops_by_reason.end());
-    REQUIRE(overflow_it->second > 0);
+    REQUIRE(overflow_drops > 0);
+    REQUIRE(dropsFor(m, PacketDropSource::Processor, PacketDropReason::QueueOverflow) ==
+            overflow_drops);
     REQUIRE(m.duplicate_events == 0);
     REQUIRE(m.ingress_packets >= overload_count);
     REQUIRE(m.ingress_packets == m.terminal_events);
@@ -470,14 +485,13 @@ TEST_CASE("malformed packet failure maps to parse error drop reason",
         }));
 
     metrics = stats.snapshotAt(now_ms + packet_count);
-    const auto parse_error_it = metrics.drops_by_reason.find(PacketDropReason::ParseError);
 
     REQUIRE(metrics.ingress_packets == metrics.terminal_events);
     REQUIRE(metrics.pending_terminal_events == 0);
     REQUIRE(metrics.duplicate_events == 0);
-    REQUIRE(metrics.drops_by_reason.size() == 1);
-    REQUIRE(parse_error_it != metrics.drops_by_reason.end());
-    REQUIRE(parse_error_it->second == packet_count);
+    REQUIRE(dropsFor(metrics, PacketDropReason::ParseError) == packet_count);
+    REQUIRE(dropsFor(metrics, PacketDropSource::FailureInjector, PacketDropReason::ParseError) ==
+            packet_count);
     REQUIRE(dropsTotal(metrics) == packet_count);
 }
 
@@ -520,15 +534,13 @@ TEST_CASE("validation failure maps to validation error drop reason",
         }));
 
     metrics = stats.snapshotAt(now_ms + packet_count);
-    const auto validation_error_it =
-        metrics.drops_by_reason.find(PacketDropReason::ValidationError);
 
     REQUIRE(metrics.ingress_packets == metrics.terminal_events);
     REQUIRE(metrics.pending_terminal_events == 0);
     REQUIRE(metrics.duplicate_events == 0);
-    REQUIRE(metrics.drops_by_reason.size() == 1);
-    REQUIRE(validation_error_it != metrics.drops_by_reason.end());
-    REQUIRE(validation_error_it->second == packet_count);
+    REQUIRE(dropsFor(metrics, PacketDropReason::ValidationError) == packet_count);
+    REQUIRE(dropsFor(metrics, PacketDropSource::FailureInjector, PacketDropReason::ValidationError) ==
+            packet_count);
     REQUIRE(dropsTotal(metrics) == packet_count);
 }
 
@@ -571,15 +583,13 @@ TEST_CASE("processing rejection failure maps to processing error drop reason",
         }));
 
     metrics = stats.snapshotAt(now_ms + packet_count);
-    const auto processing_error_it =
-        metrics.drops_by_reason.find(PacketDropReason::ProcessingError);
 
     REQUIRE(metrics.ingress_packets == metrics.terminal_events);
     REQUIRE(metrics.pending_terminal_events == 0);
     REQUIRE(metrics.duplicate_events == 0);
-    REQUIRE(metrics.drops_by_reason.size() == 1);
-    REQUIRE(processing_error_it != metrics.drops_by_reason.end());
-    REQUIRE(processing_error_it->second == packet_count);
+    REQUIRE(dropsFor(metrics, PacketDropReason::ProcessingError) == packet_count);
+    REQUIRE(dropsFor(metrics, PacketDropSource::FailureInjector, PacketDropReason::ProcessingError) ==
+            packet_count);
     REQUIRE(dropsTotal(metrics) == packet_count);
 }
 
@@ -808,8 +818,8 @@ TEST_CASE("failure injection under queue pressure produces correct drops",
 
     metrics = stats.snapshotAt(now_ms + packet_count);
     const std::uint64_t drops_total = dropsTotal(metrics);
-    const auto simulated_loss_it = metrics.drops_by_reason.find(PacketDropReason::SimulatedLoss);
-    const auto queue_overflow_it = metrics.drops_by_reason.find(PacketDropReason::QueueOverflow);
+    const std::uint64_t simulated_loss = dropsFor(metrics, PacketDropReason::SimulatedLoss);
+    const std::uint64_t queue_overflow = dropsFor(metrics, PacketDropReason::QueueOverflow);
 
     REQUIRE(metrics.pending_terminal_events == 0);
     REQUIRE(metrics.duplicate_events == 0);
@@ -817,9 +827,471 @@ TEST_CASE("failure injection under queue pressure produces correct drops",
     REQUIRE(metrics.processed_packets > 0);
     REQUIRE(metrics.processed_packets + drops_total == metrics.terminal_events);
     REQUIRE(drops_total > 0);
-    REQUIRE(simulated_loss_it != metrics.drops_by_reason.end());
-    REQUIRE(simulated_loss_it->second > 0);
-    REQUIRE(queue_overflow_it != metrics.drops_by_reason.end());
-    REQUIRE(queue_overflow_it->second > 0);
-    REQUIRE(simulated_loss_it->second + queue_overflow_it->second <= drops_total);
+    REQUIRE(simulated_loss > 0);
+    REQUIRE(queue_overflow > 0);
+    REQUIRE(simulated_loss + queue_overflow <= drops_total);
+    REQUIRE(dropsFor(metrics, PacketDropSource::FailureInjector,
+                     PacketDropReason::SimulatedLoss) == simulated_loss);
+    REQUIRE(dropsFor(metrics, PacketDropSource::Processor, PacketDropReason::QueueOverflow) ==
+            queue_overflow);
+}
+
+TEST_CASE("Packet flow hash prefers (ingress_port, source_mac) over the UDP source",
+          "[PacketPipeline]")
+{
+    Packet first{};
+    first.source_ipv4 = makeIpv4(10, 0, 0, 1);
+    first.source_port = 4000;
+    first.setIngressPort(2);
+    first.setSourceMac(MacAddress::fromString("AA:BB:CC:DD:EE:01"));
+
+    Packet second = first;
+    second.source_ipv4 = makeIpv4(10, 0, 0, 2);
+    second.source_port = 5000;
+
+    REQUIRE(packetFlowHash(first) == packetFlowHash(second));
+
+    second.setIngressPort(3);
+    REQUIRE(packetFlowHash(first) != packetFlowHash(second));
+
+    Packet udp_only{};
+    udp_only.source_ipv4 = makeIpv4(10, 0, 0, 1);
+    udp_only.source_port = 4000;
+
+    Packet other_port = udp_only;
+    other_port.source_port = 4001;
+
+    REQUIRE(packetFlowHash(udp_only) != packetFlowHash(other_port));
+}
+
+TEST_CASE("Packet header stores optional forwarding fields in its cache line",
+          "[PacketPipeline]")
+{
+    Packet packet{};
+    REQUIRE_FALSE(packet.sourceMac().has_value());
+    REQUIRE_FALSE(packet.destinationMac().has_value());
+    REQUIRE_FALSE(packet.ingressPort().has_value());
+
+    packet.setSourceMac(MacAddress::fromString("AA:BB:CC:DD:EE:01"));
+    packet.setDestinationMac(MacAddress::fromString("FF:FF:FF:FF:FF:FF"));
+    packet.setIngressPort(0);
+
+    REQUIRE(packet.sourceMac() == MacAddress::fromString("AA:BB:CC:DD:EE:01"));
+    REQUIRE(packet.destinationMac()->isBroadcast());
+    REQUIRE(packet.ingressPort() == 0u);
+
+    packet.setSourceMac(std::nullopt);
+    packet.setIngressPort(std::nullopt);
+
+    REQUIRE_FALSE(packet.sourceMac().has_value());
+    REQUIRE(packet.destinationMac().has_value());
+    REQUIRE_FALSE(packet.ingressPort().has_value());
+
+    REQUIRE(formatIpv4(makeIpv4(192, 0, 2, 254)) == "192.0.2.254");
+}
+
+TEST_CASE("Multi-worker PacketProcessor keeps each flow on one worker and in order",
+          "[PacketPipeline]")
+{
+    constexpr std::uint32_t worker_count = 4;
+    constexpr std::uint16_t flow_count = 16;
+    constexpr std::uint64_t packets_per_flow = 32;
+
+    MessagingBus bus;
+    PacketStats stats(bus);
+
+    std::mutex observed_mutex;
+    std::vector<Packet> observed;
+    bus.subscribe(MessageType::PacketProcessed,
+                  [&](const Message &msg)
+                  {
+                      std::lock_guard<std::mutex> lock(observed_mutex);
+                      observed.push_back(std::get<Packet>(msg.payload));
+                  });
+
+    PacketProcessor processor(bus, nullptr, nullptr,
+                              failure::FailureInjector{failure::FailureConfig{}}, worker_count);
+    REQUIRE(processor.workerCount() == worker_count);
+
+    std::uint64_t lifecycle_id = 1;
+    for (std::uint64_t seq = 0; seq < packets_per_flow; ++seq)
+    {
+        for (std::uint16_t flow = 0; flow < flow_count; ++flow)
+        {
+            Packet packet{};
+            packet.lifecycle_id = lifecycle_id++;
+            packet.id = seq;
+            packet.timestamp_ms = 1000;
+            packet.payload = "flow";
+            packet.source_ipv4 = makeIpv4(10, 0, 0, 1);
+            packet.source_port = static_cast<std::uint16_t>(4000 + flow);
+
+            Message msg{};
+            msg.type = MessageType::PacketRx;
+            msg.timestamp_ms = packet.timestamp_ms;
+            msg.payload = packet;
+            bus.publish(msg);
+        }
+    }
+
+    const std::uint64_t total = flow_count * packets_per_flow;
+    REQUIRE(waitUntil(
+        [&]
+        {
+            std::lock_guard<std::mutex> lock(observed_mutex);
+            return observed.size() == total;
+        }));
+
+    std::map<std::uint16_t, std::uint64_t> next_seq;
+    std::set<std::uint32_t> used_workers;
+
+    {
+        std::lock_guard<std::mutex> lock(observed_mutex);
+        for (const auto &packet : observed)
+        {
+            REQUIRE(packet.processor_worker.has_value());
+            REQUIRE(*packet.processor_worker == processor.workerFor(packet));
+            REQUIRE(packet.id == next_seq[packet.source_port]);
+            ++next_seq[packet.source_port];
+            used_workers.insert(*packet.processor_worker);
+        }
+    }
+
+    REQUIRE(used_workers.size() > 1);
+
+    const auto metrics = stats.snapshotAt(2000);
+    std::uint64_t processed_by_workers = 0;
+
+    for (std::uint32_t id = 0; id < metrics.packet_worker_count; ++id)
+    {
+        processed_by_workers += metrics.packet_workers[id].processed_packets;
+
+        if (metrics.packet_workers[id].processed_packets != 0)
+        {
+            REQUIRE(metrics.packet_workers[id].max_latency_ns >=
+                    metrics.packet_workers[id].average_latency_ns);
+        }
+    }
+
+    REQUIRE(metrics.packet_worker_count <= worker_count);
+    REQUIRE(processed_by_workers == total);
+}
+
+TEST_CASE("LifecycleDedupWindow flags repeated ids", "[PacketPipeline][dedup]")
+{
+    LifecycleDedupWindow window;
+
+    REQUIRE(window.mark(1) == LifecycleMark::New);
+    REQUIRE(window.mark(2) == LifecycleMark::New);
+    REQUIRE(window.mark(1) == LifecycleMark::Duplicate);
+    REQUIRE(window.mark(LifecycleDedupWindow::IdsPerSlot + 1) == LifecycleMark::New);
+    REQUIRE(window.mark(2) == LifecycleMark::Duplicate);
+}
+
+TEST_CASE("LifecycleDedupWindow slides forward and reports ids behind it",
+          "[PacketPipeline][dedup]")
+{
+    LifecycleDedupWindow window;
+    constexpr std::uint64_t span = LifecycleDedupWindow::Span;
+
+    REQUIRE(window.mark(5) == LifecycleMark::New);
+
+    // Out-of-order completion inside the window is still checked exactly.
+    REQUIRE(window.mark(span - 1) == LifecycleMark::New);
+    REQUIRE(window.mark(6) == LifecycleMark::New);
+    REQUIRE(window.mark(5) == LifecycleMark::Duplicate);
+
+    // An id a full span ahead recycles the slot that held id 5.
+    REQUIRE(window.mark(span + 5) == LifecycleMark::New);
+    REQUIRE(window.mark(5) == LifecycleMark::TooOld);
+    REQUIRE(window.mark(7) == LifecycleMark::TooOld);
+    REQUIRE(window.mark(span + 5) == LifecycleMark::Duplicate);
+    REQUIRE(window.mark(span - 1) == LifecycleMark::Duplicate);
+}
+
+TEST_CASE("LifecycleDedupWindow handles ids past the 32-bit block tag range",
+          "[PacketPipeline][dedup]")
+{
+    LifecycleDedupWindow window;
+    constexpr std::uint64_t span = LifecycleDedupWindow::Span;
+    constexpr std::uint64_t base = (1ull << 40) + 3;
+
+    REQUIRE(window.mark(base) == LifecycleMark::New);
+    REQUIRE(window.mark(base) == LifecycleMark::Duplicate);
+    REQUIRE(window.mark(base + span) == LifecycleMark::New);
+    REQUIRE(window.mark(base) == LifecycleMark::TooOld);
+    REQUIRE(window.mark(base + span) == LifecycleMark::Duplicate);
+}
+
+TEST_CASE("LifecycleDedupWindow marks each id once across threads", "[PacketPipeline][dedup]")
+{
+    LifecycleDedupWindow window;
+    constexpr std::uint64_t ids = 50'000;
+    constexpr int threads = 4;
+
+    std::atomic<std::uint64_t> fresh{0};
+    std::atomic<std::uint64_t> duplicates{0};
+    std::vector<std::thread> workers;
+
+    // Every thread marks every id, so each id is New exactly once.
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back(
+            [&]
+            {
+                for (std::uint64_t id = 1; id <= ids; ++id)
+                {
+                    if (window.mark(id) == LifecycleMark::New)
+                        fresh.fetch_add(1, std::memory_order_relaxed);
+                    else
+                        duplicates.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+    }
+
+    for (auto &worker : workers)
+        worker.join();
+
+    REQUIRE(fresh.load() == ids);
+    REQUIRE(duplicates.load() == ids * (threads - 1));
+}
+
+TEST_CASE("PacketStats counts repeated and stale terminal events", "[PacketPipeline][dedup]")
+{
+    MessagingBus bus;
+    PacketStats stats(bus);
+
+    stats.onTerminal(LifecycleDedupWindow::Span + 10);
+    stats.onTerminal(LifecycleDedupWindow::Span + 10);
+    stats.onTerminal(10);
+
+    Message drop{};
+    drop.type = MessageType::PacketDropped;
+    drop.payload = PacketDropped{.reason = PacketDropReason::ValidationError,
+                                 .timestamp_ms = 0,
+                                 .lifecycle_id = LifecycleDedupWindow::Span + 11};
+    bus.publish(drop);
+    bus.publish(drop);
+
+    const auto metrics = stats.snapshotAt(0);
+
+    REQUIRE(metrics.terminal_events == 3);
+    REQUIRE(metrics.duplicate_events == 2);
+    REQUIRE(metrics.stale_lifecycle_events == 1);
+    REQUIRE(dropsTotal(metrics) == 1);
+}
+
+TEST_CASE("PacketStats deduplicates each receiver's lifecycle ids separately",
+          "[PacketPipeline][dedup]")
+{
+    MessagingBus bus;
+    constexpr std::uint32_t receivers = 2;
+    PacketStats stats(bus, nullptr, receivers);
+
+    LifecycleIdGenerator idle_receiver(1, receivers);
+    LifecycleIdGenerator busy_receiver(2, receivers);
+
+    // One pinned flow keeps receiver 1 far more than a window span ahead of receiver 0.
+    constexpr std::uint64_t busy_ids = LifecycleDedupWindow::Span + 70'000;
+    for (std::uint64_t i = 0; i < busy_ids; ++i)
+        stats.onTerminal(busy_receiver.next());
+
+    constexpr std::uint64_t idle_ids = 1000;
+    std::uint64_t repeated_id = 0;
+    for (std::uint64_t i = 0; i < idle_ids; ++i)
+    {
+        const auto id = idle_receiver.next();
+        stats.onTerminal(id);
+
+        if (i == idle_ids / 2)
+            repeated_id = id;
+    }
+
+    stats.onTerminal(repeated_id);
+
+    const auto metrics = stats.snapshotAt(0);
+
+    REQUIRE(metrics.stale_lifecycle_events == 0);
+    REQUIRE(metrics.duplicate_events == 1);
+    REQUIRE(metrics.terminal_events == busy_ids + idle_ids);
+}
+
+TEST_CASE("PacketStats folds out-of-range drop reasons and sources into fixed slots",
+          "[PacketPipeline]")
+{
+    MessagingBus bus;
+    PacketStats stats(bus);
+
+    Message drop{};
+    drop.type = MessageType::PacketDropped;
+    drop.payload = PacketDropped{.reason = static_cast<PacketDropReason>(200),
+                                 .source = static_cast<PacketDropSource>(9),
+                                 .timestamp_ms = 0,
+                                 .lifecycle_id = 1};
+    bus.publish(drop);
+
+    const auto metrics = stats.snapshotAt(0);
+
+    REQUIRE(dropsFor(metrics, PacketDropReason::Unknown) == 1);
+    REQUIRE(dropsFor(metrics, PacketDropSource::Ingress, PacketDropReason::Unknown) == 1);
+    REQUIRE(dropsTotal(metrics) == 1);
+    REQUIRE(stats.drops() == 1);
+}
+
+TEST_CASE("PacketStats exposes ingress-to-processed latency percentiles", "[PacketPipeline]")
+{
+    MessagingBus bus;
+    PacketStats stats(bus);
+
+    const std::uint64_t now_ns = nowNs();
+
+    Message msg{};
+    msg.type = MessageType::PacketProcessed;
+
+    for (std::uint64_t i = 0; i < 100; ++i)
+    {
+        Packet packet{};
+        packet.lifecycle_id = i + 1;
+        packet.processor_worker = static_cast<std::uint32_t>(i % 2);
+        // Ninety fast packets and ten that waited about a second.
+        packet.ingress_timestamp_ns = now_ns - (i < 90 ? 1'000 : 1'000'000'000);
+        msg.payload = packet;
+        bus.publish(msg);
+    }
+
+    const auto metrics = stats.snapshotAt(0);
+
+    REQUIRE(metrics.processing_latency.count == 100);
+    REQUIRE(metrics.processing_latency.p50_ns < 1'000'000'000);
+    REQUIRE(metrics.processing_latency.p99_ns >= 1'000'000'000);
+    REQUIRE(metrics.processing_latency.max_ns >= 1'000'000'000);
+    REQUIRE(stats.processingLatency().count() == 100);
+}
+
+TEST_CASE("PacketStats latency window resets on every read", "[PacketPipeline]")
+{
+    MessagingBus bus;
+    PacketStats stats(bus);
+
+    std::uint64_t next_lifecycle_id = 1;
+    const auto publishProcessed = [&](std::uint64_t count)
+    {
+        Message msg{};
+        msg.type = MessageType::PacketProcessed;
+
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            Packet packet{};
+            packet.lifecycle_id = next_lifecycle_id++;
+            packet.processor_worker = 0;
+            packet.ingress_timestamp_ns = nowNs() - 1'000;
+            msg.payload = packet;
+            bus.publish(msg);
+        }
+    };
+
+    publishProcessed(100);
+
+    // The first read covers everything since start and has no previous read to measure from.
+    const auto first = stats.takeProcessingLatencyWindow(10'000);
+    REQUIRE(first.latency.count == 100);
+    REQUIRE(first.window_ms == 0);
+
+    publishProcessed(30);
+
+    const auto second = stats.takeProcessingLatencyWindow(11'500);
+    REQUIRE(second.latency.count == 30);
+    REQUIRE(second.window_ms == 1'500);
+
+    const auto third = stats.takeProcessingLatencyWindow(12'000);
+    REQUIRE(third.latency.count == 0);
+    REQUIRE(third.window_ms == 500);
+
+    // Reads never reset the recorders, so the cumulative view keeps every sample.
+    REQUIRE(stats.snapshotAt(12'000).processing_latency.count == 130);
+}
+
+TEST_CASE("PipelineStamps measures only the stages a packet passed through",
+          "[PacketPipeline][stages]")
+{
+    PipelineStamps stamps;
+
+    stamps.mark(PipelineStage::ParseValidate);
+    REQUIRE_FALSE(stamps.started());
+    REQUIRE_FALSE(stamps.stageNs(PipelineStage::ParseValidate));
+
+    stamps.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    stamps.mark(PipelineStage::ParseValidate);
+    stamps.mark(PipelineStage::Echo);
+    stamps.mark(PipelineStage::BusPublish);
+
+    const auto parse = stamps.stageNs(PipelineStage::ParseValidate);
+    REQUIRE(parse);
+    REQUIRE(*parse >= 1'000'000);
+    REQUIRE(*parse < 1'000'000'000);
+    REQUIRE(stamps.stageNs(PipelineStage::Echo));
+    REQUIRE(stamps.stageNs(PipelineStage::BusPublish));
+
+    // Switching never ran, so neither it nor the stage after it has a duration.
+    stamps.mark(PipelineStage::Transport);
+    REQUIRE_FALSE(stamps.stageNs(PipelineStage::QueueWait));
+    REQUIRE_FALSE(stamps.stageNs(PipelineStage::Switching));
+    REQUIRE_FALSE(stamps.stageNs(PipelineStage::Transport));
+}
+
+TEST_CASE("PacketStats records per-stage latency for processed packets",
+          "[PacketPipeline][stages]")
+{
+    PacketPipelineFixture fixture;
+    MessagingBus &bus = fixture.bus;
+    PacketStats &stats = fixture.stats;
+    constexpr std::uint64_t packet_count = 20;
+
+    Message msg{};
+    msg.type = MessageType::PacketRx;
+
+    for (std::uint64_t i = 0; i < packet_count; ++i)
+    {
+        Packet packet{};
+        packet.lifecycle_id = i + 1;
+        packet.id = i + 1;
+        packet.timestamp_ms = 1000 + i;
+        packet.payload = std::string(32, 's');
+        packet.stages.start();
+        packet.stages.mark(PipelineStage::ParseValidate);
+        packet.stages.mark(PipelineStage::Echo);
+        msg.timestamp_ms = packet.timestamp_ms;
+        msg.payload = packet;
+        bus.publish(msg);
+    }
+
+    // One packet that did not come through a receiver contributes no stage samples.
+    Packet untimed{};
+    untimed.lifecycle_id = packet_count + 1;
+    untimed.id = packet_count + 1;
+    untimed.timestamp_ms = 2000;
+    untimed.payload = std::string(32, 'u');
+    msg.payload = untimed;
+    bus.publish(msg);
+
+    PacketMetrics metrics{};
+    REQUIRE(waitUntil(
+        [&]
+        {
+            metrics = stats.snapshotAt(0);
+            return metrics.processed_packets == packet_count + 1;
+        }));
+
+    const auto stage = [&](PipelineStage s)
+    { return metrics.stage_latency[static_cast<std::size_t>(s)]; };
+
+    REQUIRE(stage(PipelineStage::ParseValidate).count == packet_count);
+    REQUIRE(stage(PipelineStage::Echo).count == packet_count);
+    REQUIRE(stage(PipelineStage::BusPublish).count == packet_count);
+    REQUIRE(stage(PipelineStage::QueueWait).count == packet_count);
+    // No forwarding engine in this fixture.
+    REQUIRE(stage(PipelineStage::Switching).count == 0);
+    REQUIRE(stage(PipelineStage::Transport).count == 0);
+    REQUIRE(stats.stageLatency(PipelineStage::QueueWait).count() == packet_count);
 }
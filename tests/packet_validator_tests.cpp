@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "edgenetswitch/packet/PacketValidator.hpp"
+
+using namespace edgenetswitch;
+
+namespace
+{
+    // Reference definition the kernels must agree with.
+    PayloadScan referenceScan(const std::string &payload)
+    {
+        PayloadScan scan{};
+
+        for (const char c : payload)
+        {
+            const auto byte = static_cast<unsigned char>(c);
+            const bool whitespace =
+                byte == ' ' || byte == '\t' || byte == '\n' || byte == '\v' || byte == '\f' ||
+                byte == '\r';
+
+            if (!whitespace)
+                scan.all_whitespace = false;
+
+            if ((byte < 0x20 && !whitespace) || byte == 0x7F)
+                scan.has_control = true;
+        }
+
+        return scan;
+    }
+
+    Packet makePacket(std::string payload)
+    {
+        Packet packet;
+        packet.id = 1;
+        packet.valid = true;
+        packet.source_ipv4 = makeIpv4(127, 0, 0, 1);
+        packet.payload = std::move(payload);
+        return packet;
+    }
+
+    constexpr PayloadScanKernel Kernels[] = {PayloadScanKernel::Scalar, PayloadScanKernel::Sse2,
+                                             PayloadScanKernel::Avx2};
+} // namespace
+
+TEST_CASE("PacketValidator rejects empty and whitespace-only payloads", "[PacketValidator]")
+{
+    REQUIRE(PacketValidator::validate(makePacket("")).reason == PacketRejectReason::EmptyPayload);
+    REQUIRE(PacketValidator::validate(makePacket(" \t\r\n\v\f")).reason ==
+            PacketRejectReason::EmptyPayload);
+    REQUIRE(PacketValidator::validate(makePacket(std::string(100, ' '))).reason ==
+            PacketRejectReason::EmptyPayload);
+    REQUIRE(PacketValidator::validate(makePacket("  hello\n")).accepted);
+}
+
+TEST_CASE("PacketValidator rejects control bytes but accepts UTF-8", "[PacketValidator]")
+{
+    REQUIRE(PacketValidator::validate(makePacket(std::string("a\0b", 3))).reason ==
+            PacketRejectReason::NonPrintablePayload);
+    REQUIRE(PacketValidator::validate(makePacket(std::string(40, 'x') + "\x7f")).reason ==
+            PacketRejectReason::NonPrintablePayload);
+    REQUIRE(PacketValidator::validate(makePacket("gr\xc3\xbc\xc3\x9f")).accepted);
+}
+
+TEST_CASE("PacketValidator accepts arbitrary bytes in binary-format payloads", "[PacketValidator]")
+{
+    Packet binary = makePacket(std::string("\x00\x01\x7f\x1b", 4));
+    binary.setWireFormat(PacketWireFormat::Binary);
+    REQUIRE(PacketValidator::validate(binary).accepted);
+
+    binary.payload = std::string(" \t\n");
+    REQUIRE(PacketValidator::validate(binary).accepted);
+
+    binary.payload = std::string();
+    REQUIRE(PacketValidator::validate(binary).reason == PacketRejectReason::EmptyPayload);
+
+    binary.payload = std::string(513, '\x01');
+    REQUIRE(PacketValidator::validate(binary).reason == PacketRejectReason::PayloadTooLarge);
+}
+
+TEST_CASE("PacketValidator keeps its check order", "[PacketValidator]")
+{
+    Packet invalid = makePacket("hello");
+    invalid.valid = false;
+    REQUIRE(PacketValidator::validate(invalid).reason == PacketRejectReason::InvalidFormat);
+
+    Packet anonymous = makePacket("hello");
+    anonymous.source_ipv4 = 0;
+    REQUIRE(PacketValidator::validate(anonymous).reason == PacketRejectReason::MissingSource);
+
+    REQUIRE(PacketValidator::validate(makePacket(std::string(512, 'x'))).accepted);
+    REQUIRE(PacketValidator::validate(makePacket(std::string(513, '\x01'))).reason ==
+            PacketRejectReason::PayloadTooLarge);
+}
+
+TEST_CASE("Payload scan kernels match the reference on fuzzed inputs", "[PacketValidator]")
+{
+    std::mt19937 rng(0xED6E);
+    std::uniform_int_distribution<int> anyByte(0, 255);
+    std::uniform_int_distribution<int> length(0, 200);
+    std::uniform_int_distribution<int> mode(0, 3);
+
+    const std::string whitespace = " \t\n\v\f\r";
+    std::uniform_int_distribution<std::size_t> whitespaceIndex(0, whitespace.size() - 1);
+
+    for (int iteration = 0; iteration < 20000; ++iteration)
+    {
+        std::string payload(static_cast<std::size_t>(length(rng)), '\0');
+        const int shape = mode(rng);
+
+        for (auto &c : payload)
+        {
+            // Mostly whitespace or printable so both flags flip late as well as early.
+            if (shape == 0)
+                c = static_cast<char>(anyByte(rng));
+            else if (shape == 1)
+                c = whitespace[whitespaceIndex(rng)];
+            else
+                c = static_cast<char>(0x20 + anyByte(rng) % 0x5F);
+        }
+
+        if (shape >= 2 && !payload.empty())
+        {
+            std::uniform_int_distribution<std::size_t> position(0, payload.size() - 1);
+            payload[position(rng)] = static_cast<char>(anyByte(rng));
+        }
+
+        const PayloadScan expected = referenceScan(payload);
+
+        for (const auto kernel : Kernels)
+        {
+            const PayloadScan actual = scanPayload(payload, kernel);
+            INFO("kernel=" << toString(kernel) << " size=" << payload.size());
+            REQUIRE(actual.all_whitespace == expected.all_whitespace);
+            REQUIRE(actual.has_control == expected.has_control);
+        }
+    }
+}
+
+TEST_CASE("Payload scan kernels classify every byte value at every lane", "[PacketValidator]")
+{
+    for (int value = 0; value < 256; ++value)
+    {
+        for (std::size_t position = 0; position < 40; ++position)
+        {
+            std::string payload(40, ' ');
+            payload[position] = static_cast<char>(value);
+            const PayloadScan expected = referenceScan(payload);
+
+            for (const auto kernel : Kernels)
+            {
+                const PayloadScan actual = scanPayload(payload, kernel);
+                INFO("kernel=" << toString(kernel) << " byte=" << value << " at=" << position);
+                REQUIRE(actual.all_whitespace == expected.all_whitespace);
+                REQUIRE(actual.has_control == expected.has_control);
+            }
+        }
+    }
+}
+
+TEST_CASE("Unsupported payload scan kernels fall back to scalar", "[PacketValidator]")
+{
+    REQUIRE(payloadScanKernelSupported(PayloadScanKernel::Scalar));
+    REQUIRE(payloadScanKernelSupported(activePayloadScanKernel()));
+
+    const PayloadScan scan = scanPayload("ok", PayloadScanKernel::Avx2);
+    REQUIRE_FALSE(scan.all_whitespace);
+    REQUIRE_FALSE(scan.has_control);
+}
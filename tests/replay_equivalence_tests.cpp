@@ -41,7 +41,7 @@ namespace
         packet.wire_size = static_cast<std::uint32_t>(packet.payload.size() + 16);
         packet.payload_size = static_cast<std::uint32_t>(packet.payload.size());
         packet.valid = true;
-        packet.source_ip = "203.0.113." + std::to_string(id);
+        packet.source_ipv4 = makeIpv4(203, 0, 113, static_cast<std::uint8_t>(id));
         packet.source_port = static_cast<std::uint16_t>(14000 + id);
         return packet;
     }
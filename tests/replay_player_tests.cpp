@@ -26,7 +26,7 @@ namespace
         packet.wire_size = static_cast<std::uint32_t>(packet.payload.size() + 16);
         packet.payload_size = static_cast<std::uint32_t>(packet.payload.size());
         packet.valid = true;
-        packet.source_ip = "198.51.100." + std::to_string(id);
+        packet.source_ipv4 = makeIpv4(198, 51, 100, static_cast<std::uint8_t>(id));
         packet.source_port = static_cast<std::uint16_t>(12000 + id);
         return packet;
     }
@@ -52,7 +52,7 @@ namespace
         REQUIRE(actual.wire_size == expected.wire_size);
         REQUIRE(actual.payload_size == expected.payload_size);
         REQUIRE(actual.valid == expected.valid);
-        REQUIRE(actual.source_ip == expected.source_ip);
+        REQUIRE(actual.source_ipv4 == expected.source_ipv4);
         REQUIRE(actual.source_port == expected.source_port);
     }
 
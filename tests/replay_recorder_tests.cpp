@@ -20,7 +20,7 @@ namespace
         packet.wire_size = static_cast<std::uint32_t>(packet.payload.size() + 16);
         packet.payload_size = static_cast<std::uint32_t>(packet.payload.size());
         packet.valid = true;
-        packet.source_ip = "192.0.2." + std::to_string(id);
+        packet.source_ipv4 = makeIpv4(192, 0, 2, static_cast<std::uint8_t>(id));
         packet.source_port = static_cast<std::uint16_t>(10000 + id);
         return packet;
     }
@@ -59,7 +59,7 @@ TEST_CASE("ReplayRecorder records PacketRx events", "[ReplayRecorder]")
     REQUIRE(records[0].packet.lifecycle_id == packet.lifecycle_id);
     REQUIRE(records[0].packet.timestamp_ms == packet.timestamp_ms);
     REQUIRE(records[0].packet.payload == packet.payload);
-    REQUIRE(records[0].packet.source_ip == packet.source_ip);
+    REQUIRE(records[0].packet.source_ipv4 == packet.source_ipv4);
     REQUIRE(records[0].packet.source_port == packet.source_port);
 }
 
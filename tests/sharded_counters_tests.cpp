@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "edgenetswitch/core/ShardedCounters.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace edgenetswitch;
+
+TEST_CASE("ShardedCounters shards are cache-line aligned", "[ShardedCounters]")
+{
+    STATIC_REQUIRE(sizeof(ShardedCounters<1>) == 64 * ShardedCounters<1>::Shards);
+    STATIC_REQUIRE(sizeof(ShardedCounters<9>) == 128 * ShardedCounters<9>::Shards);
+}
+
+TEST_CASE("ShardedCounters adds and resets per counter", "[ShardedCounters]")
+{
+    ShardedCounters<3> counters;
+
+    counters.add(0);
+    counters.add(0);
+    counters.add(2, 40);
+
+    REQUIRE(counters.load(0) == 2);
+    REQUIRE(counters.load(1) == 0);
+    REQUIRE(counters.load(2) == 40);
+
+    const auto totals = counters.snapshot();
+    REQUIRE(totals[0] == 2);
+    REQUIRE(totals[1] == 0);
+    REQUIRE(totals[2] == 40);
+
+    counters.reset();
+    REQUIRE(counters.snapshot() == std::array<std::uint64_t, 3>{});
+}
+
+TEST_CASE("ShardedCounters sums every thread's adds, including more threads than shards",
+          "[ShardedCounters]")
+{
+    constexpr int threads = ShardedCounters<2>::Shards + 8;
+    constexpr std::uint64_t per_thread = 10'000;
+
+    ShardedCounters<2> counters;
+    std::atomic<bool> stop{false};
+    std::atomic<bool> went_backwards{false};
+    std::vector<std::thread> writers;
+
+    // A reader summing concurrently must only ever see totals grow.
+    std::thread reader(
+        [&]
+        {
+            std::uint64_t last = 0;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const auto now = counters.load(0);
+                if (now < last)
+                    went_backwards.store(true, std::memory_order_relaxed);
+                last = now;
+            }
+        });
+
+    for (int t = 0; t < threads; ++t)
+    {
+        writers.emplace_back(
+            [&]
+            {
+                for (std::uint64_t i = 0; i < per_thread; ++i)
+                {
+                    counters.add(0);
+                    counters.add(1, 3);
+                }
+            });
+    }
+
+    for (auto &writer : writers)
+        writer.join();
+
+    stop.store(true, std::memory_order_relaxed);
+    reader.join();
+
+    REQUIRE_FALSE(went_backwards.load());
+    REQUIRE(counters.load(0) == threads * per_thread);
+    REQUIRE(counters.load(1) == 3 * threads * per_thread);
+}
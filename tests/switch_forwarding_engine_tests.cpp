@@ -3,11 +3,16 @@
 #include "edgenetswitch/packet/Packet.hpp"
 #include "edgenetswitch/switching/ForwardingDecision.hpp"
 #include "edgenetswitch/switching/InterfaceRegistry.hpp"
+#include "edgenetswitch/switching/ForwardingEvent.hpp"
 #include "edgenetswitch/switching/MacAddress.hpp"
+#include "edgenetswitch/switching/PortSet.hpp"
 #include "edgenetswitch/switching/SwitchForwardingEngine.hpp"
 #include "edgenetswitch/switching/SwitchPort.hpp"
 
+#include <atomic>
 #include <cstdint>
+#include <cstdlib>
+#include <new>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -15,6 +20,33 @@
 
 using namespace edgenetswitch;
 
+// Counts every global heap allocation in this test binary so the forwarding fast path can be
+// checked for zero allocations per packet.
+namespace
+{
+    std::atomic<std::uint64_t> g_heap_allocations{0};
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
 namespace
 {
     MacAddress mac(std::string_view text)
@@ -34,8 +66,8 @@ namespace
         packet.payload_size = static_cast<std::uint32_t>(packet.payload.size());
         packet.wire_size = packet.payload_size + 14;
         packet.valid = true;
-        packet.source_mac = source;
-        packet.destination_mac = destination;
+        packet.setSourceMac(source);
+        packet.setDestinationMac(destination);
         return packet;
     }
 
@@ -91,7 +123,7 @@ TEST_CASE("SwitchForwardingEngine drops packets without MAC addresses",
     SECTION("missing source")
     {
         Packet packet = makePacketWithoutMacs();
-        packet.destination_mac = mac("00:11:22:33:44:55");
+        packet.setDestinationMac(mac("00:11:22:33:44:55"));
 
         const ForwardingDecision decision = engine.processPacket(packet, 1, 10);
 
@@ -103,7 +135,7 @@ TEST_CASE("SwitchForwardingEngine drops packets without MAC addresses",
     SECTION("missing destination")
     {
         Packet packet = makePacketWithoutMacs();
-        packet.source_mac = mac("00:11:22:33:44:66");
+        packet.setSourceMac(mac("00:11:22:33:44:66"));
 
         const ForwardingDecision decision = engine.processPacket(packet, 1, 10);
 
@@ -125,7 +157,7 @@ TEST_CASE("SwitchForwardingEngine floods broadcast packets except ingress",
     const ForwardingDecision decision = engine.processPacket(packet, 2, 10);
 
     REQUIRE(decision.action == ForwardingAction::Flood);
-    REQUIRE(decision.egress_ports == std::vector<std::uint32_t>{1, 3, 4});
+    REQUIRE(decision.egress_ports == PortSet{1, 3, 4});
 }
 
 TEST_CASE("SwitchForwardingEngine floods unknown unicast packets except ingress",
@@ -140,7 +172,7 @@ TEST_CASE("SwitchForwardingEngine floods unknown unicast packets except ingress"
     const ForwardingDecision decision = engine.processPacket(packet, 3, 10);
 
     REQUIRE(decision.action == ForwardingAction::Flood);
-    REQUIRE(decision.egress_ports == std::vector<std::uint32_t>{1, 2, 4});
+    REQUIRE(decision.egress_ports == PortSet{1, 2, 4});
 }
 
 TEST_CASE("SwitchForwardingEngine forwards known unicast packets to learned port only",
@@ -157,7 +189,7 @@ TEST_CASE("SwitchForwardingEngine forwards known unicast packets to learned port
     const ForwardingDecision decision = engine.processPacket(packet, 2, 10);
 
     REQUIRE(decision.action == ForwardingAction::ForwardToPorts);
-    REQUIRE(decision.egress_ports == std::vector<std::uint32_t>{4});
+    REQUIRE(decision.egress_ports == PortSet{4});
 }
 
 TEST_CASE("known unicast packets to DOWN destination ports are dropped",
@@ -215,3 +247,67 @@ TEST_CASE("SwitchForwardingEngine relearns source MAC on new ingress port",
     REQUIRE(second_decision.action == ForwardingAction::Flood);
     REQUIRE(mac_table.lookup(source) == 3);
 }
+
+TEST_CASE("SwitchForwardingEngine fast path performs no heap allocations",
+          "[SwitchForwardingEngine]")
+{
+    MacTable mac_table(64);
+    InterfaceRegistry interfaces = makeInterfaces();
+    SwitchForwardingEngine engine(mac_table, interfaces);
+
+    const MacAddress known = mac("00:11:22:33:44:02");
+    const MacAddress broadcast = mac("ff:ff:ff:ff:ff:ff");
+    const MacAddress unknown = mac("00:11:22:33:44:99");
+    mac_table.learn(known, 4, 1);
+
+    std::vector<Packet> packets;
+    for (std::uint64_t i = 0; i < 32; ++i)
+    {
+        const MacAddress source = MacAddress::fromPacked(0x020000000000ull + i);
+        packets.push_back(makePacket(source, broadcast));
+        packets.push_back(makePacket(source, unknown));
+        packets.push_back(makePacket(source, known));
+    }
+
+    std::uint64_t flooded = 0;
+    std::uint64_t forwarded = 0;
+    const std::uint64_t before = g_heap_allocations.load(std::memory_order_relaxed);
+
+    for (std::uint64_t tick = 2; tick < 34; ++tick)
+    {
+        for (const Packet &packet : packets)
+        {
+            const ForwardingDecision decision = engine.processPacket(packet, 2, tick);
+            const ForwardingEvent event{.lifecycle_id = packet.lifecycle_id,
+                                        .action = decision.action,
+                                        .egress_ports = decision.egress_ports};
+
+            flooded += event.action == ForwardingAction::Flood ? event.egress_ports.size() : 0;
+            forwarded += event.action == ForwardingAction::ForwardToPorts ? 1 : 0;
+        }
+    }
+
+    const std::uint64_t allocations =
+        g_heap_allocations.load(std::memory_order_relaxed) - before;
+
+    REQUIRE(allocations == 0);
+    REQUIRE(flooded == 32 * 64 * 3);
+    REQUIRE(forwarded == 32 * 32);
+}
+
+TEST_CASE("PortSet iterates egress ports in ascending order", "[SwitchForwardingEngine]")
+{
+    const PortSet ports{200, 4, 63, 64, 1};
+
+    std::vector<std::uint32_t> ordered;
+    for (const std::uint32_t port : ports)
+    {
+        ordered.push_back(port);
+    }
+
+    REQUIRE(ordered == std::vector<std::uint32_t>{1, 4, 63, 64, 200});
+    REQUIRE(ports.size() == 5);
+    REQUIRE(ports.contains(64));
+    REQUIRE_FALSE(ports.contains(65));
+    REQUIRE(PortSet{}.begin() == PortSet{}.end());
+}
@@ -0,0 +1,318 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "edgenetswitch/messaging/MessagingBus.hpp"
+#include "edgenetswitch/network/IngressMode.hpp"
+#include "edgenetswitch/network/UdpReceiver.hpp"
+#include "edgenetswitch/packet/LifecycleIdGenerator.hpp"
+#include "edgenetswitch/packet/PacketParser.hpp"
+#include "edgenetswitch/packet/PacketStats.hpp"
+#include "edgenetswitch/system/fd/FdRegistry.hpp"
+
+#include <arpa/inet.h>
+#include <cstdint>
+#include <netinet/in.h>
+#include <set>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+using namespace edgenetswitch;
+
+namespace
+{
+    std::uint16_t boundPort(int fd)
+    {
+        sockaddr_in addr{};
+        socklen_t len = sizeof(addr);
+        REQUIRE(::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len) == 0);
+        return ntohs(addr.sin_port);
+    }
+
+    void sendWires(std::uint16_t port, const std::vector<std::string> &wires)
+    {
+        const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+        REQUIRE(fd >= 0);
+
+        sockaddr_in destination{};
+        destination.sin_family = AF_INET;
+        destination.sin_port = htons(port);
+        destination.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        for (const auto &wire : wires)
+        {
+            REQUIRE(::sendto(fd, wire.data(), wire.size(), 0,
+                             reinterpret_cast<const sockaddr *>(&destination),
+                             sizeof(destination)) == static_cast<ssize_t>(wire.size()));
+        }
+
+        ::close(fd);
+    }
+
+    void sendDatagrams(std::uint16_t port, std::size_t count)
+    {
+        std::vector<std::string> wires;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            wires.push_back("id=" + std::to_string(i + 1) + ";payload=batch");
+        }
+
+        sendWires(port, wires);
+    }
+} // namespace
+
+TEST_CASE("Batched UdpReceiver drains queued datagrams with recvmmsg", "[UdpReceiver]")
+{
+    MessagingBus bus;
+    PacketStats stats(bus);
+    FdRegistry registry;
+
+    std::uint64_t rx_count = 0;
+    bus.subscribe(MessageType::PacketRx, [&](const Message &) { ++rx_count; });
+
+    UdpReceiver receiver(bus, 0, &registry, IngressMode::Batched, 4);
+    receiver.initializeSocket();
+    REQUIRE(receiver.fd() >= 0);
+
+    sendDatagrams(boundPort(receiver.fd()), 6);
+
+    receiver.processReadableEvent();
+
+    const auto metrics = stats.snapshotAt(0);
+
+    REQUIRE(rx_count == 6);
+    REQUIRE(metrics.ingress_packets == 6);
+    REQUIRE(metrics.udp_drain_completions == 1);
+    REQUIRE(metrics.udp_batches >= 2);
+
+    std::uint64_t histogram_total = 0;
+    for (const auto count : metrics.udp_batch_histogram)
+    {
+        histogram_total += count;
+    }
+
+    REQUIRE(histogram_total == metrics.udp_batches);
+    REQUIRE(metrics.udp_batch_histogram[udpBatchHistogramBucket(8)] == 0);
+
+    receiver.stop();
+}
+
+TEST_CASE("SO_REUSEPORT receivers share a port and issue disjoint lifecycle ids",
+          "[UdpReceiver]")
+{
+    MessagingBus bus;
+    PacketStats stats(bus);
+    FdRegistry registry;
+
+    std::set<std::uint64_t> lifecycle_ids;
+    bus.subscribe(MessageType::PacketRx,
+                  [&](const Message &msg)
+                  {
+                      const auto &packet = std::get<Packet>(msg.payload);
+                      lifecycle_ids.insert(packet.lifecycle_id);
+                      REQUIRE(packet.ingress_receiver.has_value());
+                  });
+
+    UdpReceiver first(bus, 0, &registry, IngressMode::NonBlocking, 1, 0, 2);
+    first.initializeSocket();
+    REQUIRE(first.fd() >= 0);
+
+    const auto port = boundPort(first.fd());
+
+    UdpReceiver second(bus, port, &registry, IngressMode::NonBlocking, 1, 1, 2);
+    second.initializeSocket();
+    REQUIRE(second.fd() >= 0);
+
+    // Each sender socket has its own source port, so the kernel hashes the flows across
+    // both receivers.
+    constexpr std::size_t senders = 16;
+    for (std::size_t i = 0; i < senders; ++i)
+    {
+        sendDatagrams(port, 1);
+    }
+
+    first.processReadableEvent();
+    second.processReadableEvent();
+
+    const auto metrics = stats.snapshotAt(0);
+
+    REQUIRE(lifecycle_ids.size() == senders);
+    REQUIRE(metrics.ingress_packets == senders);
+    REQUIRE(metrics.udp_receiver_count == 2);
+    REQUIRE(metrics.udp_receivers[0].drain_completions == 1);
+    REQUIRE(metrics.udp_receivers[1].drain_completions == 1);
+    REQUIRE(metrics.udp_receivers[0].ingress_packets + metrics.udp_receivers[1].ingress_packets ==
+            senders);
+
+    for (const auto id : lifecycle_ids)
+    {
+        REQUIRE(id != 0);
+    }
+
+    std::set<std::string> labels;
+    for (const auto &record : registry.snapshot())
+    {
+        labels.insert(record.label);
+    }
+
+    REQUIRE(labels.count("udp-rx-0") == 1);
+    REQUIRE(labels.count("udp-rx-1") == 1);
+
+    first.stop();
+    second.stop();
+}
+
+TEST_CASE("LifecycleIdGenerator strides keep receiver ranges disjoint", "[UdpReceiver]")
+{
+    LifecycleIdGenerator first(1, 3);
+    LifecycleIdGenerator second(2, 3);
+    LifecycleIdGenerator third(3, 3);
+
+    std::set<std::uint64_t> ids;
+    for (int i = 0; i < 100; ++i)
+    {
+        ids.insert(first.next());
+        ids.insert(second.next());
+        ids.insert(third.next());
+    }
+
+    REQUIRE(ids.size() == 300);
+    REQUIRE(*ids.begin() == 1);
+    REQUIRE(*ids.rbegin() == 300);
+}
+
+TEST_CASE("udpBatchHistogramBucket maps batch sizes to power-of-two buckets", "[UdpReceiver]")
+{
+    REQUIRE(udpBatchHistogramBucket(1) == 0);
+    REQUIRE(udpBatchHistogramBucket(2) == 1);
+    REQUIRE(udpBatchHistogramBucket(3) == 1);
+    REQUIRE(udpBatchHistogramBucket(4) == 2);
+    REQUIRE(udpBatchHistogramBucket(64) == 6);
+    REQUIRE(udpBatchHistogramBucket(1024) == UDP_BATCH_HISTOGRAM_BUCKETS - 1);
+}
+
+TEST_CASE("Pooled UdpReceiver drops datagrams once its buffer shard is exhausted",
+          "[UdpReceiver]")
+{
+    MessagingBus bus;
+    PacketBufferPool pool(2);
+    PacketStats stats(bus, &pool);
+    FdRegistry registry;
+
+    // Holding the packets keeps their slabs checked out, as a slow consumer would.
+    std::vector<Packet> held;
+    bus.subscribeSink(MessageType::PacketRx,
+                      [&](Message &&msg)
+                      { held.push_back(std::get<Packet>(std::move(msg.payload))); });
+
+    UdpReceiver receiver(bus, 0, &registry, IngressMode::NonBlocking, 1, 0, 1, &pool);
+    receiver.initializeSocket();
+    REQUIRE(receiver.fd() >= 0);
+
+    sendDatagrams(boundPort(receiver.fd()), 3);
+
+    receiver.processReadableEvent();
+
+    auto metrics = stats.snapshotAt(0);
+
+    REQUIRE(held.size() == 2);
+    REQUIRE(held[0].payload.pooled());
+    REQUIRE(held[0].payload == "batch");
+    REQUIRE(metrics.drops_by_reason[dropReasonIndex(PacketDropReason::BufferExhausted)] == 1);
+    REQUIRE(metrics.buffer_pool_capacity == 2);
+    REQUIRE(metrics.buffer_pool_in_use == 2);
+
+    held.clear();
+    metrics = stats.snapshotAt(0);
+    REQUIRE(metrics.buffer_pool_in_use == 0);
+
+    receiver.stop();
+}
+
+TEST_CASE("UdpReceiver accepts binary datagrams alongside the text format", "[UdpReceiver]")
+{
+    MessagingBus bus;
+    PacketBufferPool pool(4);
+    PacketStats stats(bus, &pool);
+    FdRegistry registry;
+
+    std::vector<Packet> received;
+    bus.subscribeSink(MessageType::PacketRx,
+                      [&](Message &&msg)
+                      { received.push_back(std::get<Packet>(std::move(msg.payload))); });
+
+    UdpReceiver receiver(bus, 0, &registry, IngressMode::NonBlocking, 1, 0, 1, &pool);
+    receiver.initializeSocket();
+    REQUIRE(receiver.fd() >= 0);
+
+    Packet binary;
+    binary.id = 900;
+    binary.payload = "binary";
+    binary.setSourceMac(MacAddress::fromPacked(0x020000000001));
+    binary.setDestinationMac(MacAddress::fromPacked(0x020000000002));
+    binary.setIngressPort(3);
+
+    std::string truncated = encodeBinaryPacket(binary);
+    truncated.resize(BINARY_PACKET_HEADER_SIZE - 1);
+
+    sendWires(boundPort(receiver.fd()),
+              {encodeBinaryPacket(binary), truncated, "id=901;payload=text"});
+
+    receiver.processReadableEvent();
+
+    auto metrics = stats.snapshotAt(0);
+
+    REQUIRE(received.size() == 2);
+    REQUIRE(received[0].id == 900);
+    REQUIRE(received[0].payload.pooled());
+    REQUIRE(received[0].payload == "binary");
+    REQUIRE(received[0].sourceMac() == binary.sourceMac());
+    REQUIRE(received[0].destinationMac() == binary.destinationMac());
+    REQUIRE(received[0].ingressPort() == 3u);
+    REQUIRE(received[1].id == 901);
+    REQUIRE_FALSE(received[1].sourceMac().has_value());
+    REQUIRE(metrics.drops_by_reason[dropReasonIndex(PacketDropReason::ParseError)] == 1);
+    REQUIRE(metrics.drops_by_source[dropSourceIndex(PacketDropSource::Ingress)]
+                                   [dropReasonIndex(PacketDropReason::ParseError)] == 1);
+
+    receiver.stop();
+}
+
+TEST_CASE("UdpReceiver forwards binary payloads containing control bytes", "[UdpReceiver]")
+{
+    MessagingBus bus;
+    PacketStats stats(bus);
+    FdRegistry registry;
+
+    std::vector<Packet> received;
+    bus.subscribeSink(MessageType::PacketRx,
+                      [&](Message &&msg)
+                      { received.push_back(std::get<Packet>(std::move(msg.payload))); });
+
+    UdpReceiver receiver(bus, 0, &registry, IngressMode::NonBlocking, 1);
+    receiver.initializeSocket();
+    REQUIRE(receiver.fd() >= 0);
+
+    const std::string frame("\x00\x01\x02\x1b\x7f\x0a\xff", 7);
+
+    Packet binary;
+    binary.id = 950;
+    binary.payload = frame;
+
+    sendWires(boundPort(receiver.fd()),
+              {encodeBinaryPacket(binary), "id=951;payload=a\x01"});
+
+    receiver.processReadableEvent();
+
+    const auto metrics = stats.snapshotAt(0);
+
+    REQUIRE(received.size() == 1);
+    REQUIRE(received[0].id == 950);
+    REQUIRE(received[0].wireFormat() == PacketWireFormat::Binary);
+    REQUIRE(received[0].payload == frame);
+    // The same bytes in a text datagram are still rejected.
+    REQUIRE(metrics.drops_by_reason[dropReasonIndex(PacketDropReason::ValidationError)] == 1);
+
+    receiver.stop();
+}